@@ -0,0 +1,245 @@
+#include "BallastExchangePlanner.h"
+#include <algorithm>
+#include <cmath>
+#include <bitset>
+
+// Implementing the constructor
+BallastExchangePlanner::BallastExchangePlanner(const Ship& ship, const ExchangeLimits& limits, size_t tanksPerStep, size_t beamWidth)
+    : model(ship.getModel()), precision(ship.getLoadingCondition().getPrecision()), limits(limits), beamWidth(std::max<size_t>(beamWidth, 1)), freeSurfaceMoment(0.0) {
+    if (tanksPerStep < 1 || tanksPerStep > 3) {
+        throw std::invalid_argument("Tanks per exchange step must range from 1 to 3.");
+    }
+    std::tie(displacement, longitudinalMoment, transverseMoment, verticalMoment) = ship.getMoments();
+
+    const LoadingCondition& loadCond = ship.getLoadingCondition();
+    for (const auto& entry : ship.getCompartments()) {
+        const std::string& key = entry.first;
+        if (key.compare(0, 3, "R1.") != 0) {
+            freeSurfaceMoment += std::get<4>(entry.second);
+        }
+        if (key.compare(0, 3, "R2.") == 0 && std::get<0>(entry.second) > 0.0 && !model.getSoundingTable(key).empty()) {
+            tanks.push_back(key);
+        }
+    }
+    std::sort(tanks.begin(), tanks.end());
+    if (tanks.size() > maxTanks) {
+        throw std::runtime_error("Too many ballast tanks to exchange: " + std::to_string(tanks.size()));
+    }
+
+    for (const std::string& key : tanks) {
+        double mass, lcg, tcg, vcg, fsm;
+        std::tie(mass, lcg, tcg, vcg, fsm) = ship.getCompartments().at(key);
+        const double fillPercentage = loadCond.getFillPercentage(key);
+        for (int half = 0; half < 2; ++half) {
+            double newMass, newLcg, newTcg, newVcg, newFsm;
+            std::tie(newMass, newLcg, newTcg, newVcg, newFsm) = loadCond.evaluateFill(model, key, half ? 0.5 * fillPercentage : 0.0);
+            if (!half) {
+                newMass = 0.0;
+                newFsm = 0.0;
+            }
+            TankChange change = { newMass - mass, newMass * newLcg - mass * lcg, newMass * newTcg + newFsm - mass * tcg - fsm,
+                newMass * newVcg - mass * vcg, newFsm - fsm };
+            (half ? halfChanges : emptyChanges).push_back(change);
+        }
+    }
+
+    // A limit the loading condition already exceeds is relaxed to the condition itself, so that the exchange may not make it worse
+    double GM;
+    ShipResults initial = evaluate(0, 0, GM);
+    this->limits.maxDraught = std::max(limits.maxDraught, std::max(initial.TF, initial.TA));
+    this->limits.maxTrim = std::max(limits.maxTrim, std::abs(initial.trim));
+    this->limits.maxHeel = std::max(limits.maxHeel, std::abs(initial.heel));
+    this->limits.minGM = std::min(limits.minGM, GM);
+    if (limits.minForwardDraught > 0.0) {
+        this->limits.minForwardDraught = std::min(limits.minForwardDraught, initial.TF);
+    }
+
+    for (size_t i = 0; i < tanks.size(); ++i) {
+        groups.push_back(uint64_t(1) << i);
+        for (size_t j = i + 1; tanksPerStep >= 2 && j < tanks.size(); ++j) {
+            groups.push_back((uint64_t(1) << i) | (uint64_t(1) << j));
+            for (size_t k = j + 1; tanksPerStep >= 3 && k < tanks.size(); ++k) {
+                groups.push_back((uint64_t(1) << i) | (uint64_t(1) << j) | (uint64_t(1) << k));
+            }
+        }
+    }
+}
+
+// Implementing the getTanks method
+const std::vector<std::string>& BallastExchangePlanner::getTanks() const {
+    return tanks;
+}
+
+// Implementing the getLimits method
+const ExchangeLimits& BallastExchangePlanner::getLimits() const {
+    return limits;
+}
+
+// Implementing the plan method
+// Each level of the beam adds one step; the candidate steps of a level are evaluated over the pool,
+// then the level is ranked and cut down to the beam width
+ExchangePlan BallastExchangePlanner::plan(WorkStealingPool& pool) const {
+    ExchangePlan plan;
+    plan.feasible = false;
+    plan.evaluations = 1;
+    double GM;
+    ShipResults initial = evaluate(0, 0, GM);
+    plan.margin = margin(initial, GM);
+    if (tanks.empty() || plan.margin < 0.0) {
+        plan.feasible = tanks.empty() && plan.margin >= 0.0;
+        return plan;
+    }
+
+    const uint64_t all = (tanks.size() == maxTanks) ? ~uint64_t(0) : (uint64_t(1) << tanks.size()) - 1;
+    std::vector<std::vector<Node>> levels;
+    levels.push_back({ { 0, 0, 0, plan.margin } });
+    struct Candidate {
+        size_t parent;
+        uint64_t group;
+        double margin;
+    };
+    std::vector<Candidate> candidates;
+    bool found = false;
+
+    while (!found && !levels.back().empty()) {
+        const std::vector<Node>& beam = levels.back();
+        candidates.clear();
+        for (size_t n = 0; n < beam.size(); ++n) {
+            for (uint64_t group : groups) {
+                if ((group & beam[n].exchanged) == 0) {
+                    candidates.push_back({ n, group, 0.0 });
+                }
+            }
+        }
+
+        // Halfway through the step, the last group refills while the new one empties; at its end, only the new group is empty
+        // The step that empties the final group is followed by its refilling, which is checked here as well
+        pool.parallelFor(candidates.size(), [&](size_t c) {
+            Candidate& candidate = candidates[c];
+            const Node& node = beam[candidate.parent];
+            double GM;
+            ShipResults halfway = evaluate(0, node.last | candidate.group, GM);
+            double worst = std::min(node.margin, margin(halfway, GM));
+            ShipResults end = evaluate(candidate.group, 0, GM);
+            worst = std::min(worst, margin(end, GM));
+            if ((node.exchanged | candidate.group) == all) {
+                ShipResults refill = evaluate(0, candidate.group, GM);
+                worst = std::min(worst, margin(refill, GM));
+            }
+            candidate.margin = worst;
+            }, 64);
+        plan.evaluations += 2 * candidates.size();
+
+        std::vector<Node> next;
+        for (const Candidate& candidate : candidates) {
+            if (candidate.margin >= 0.0) {
+                next.push_back({ beam[candidate.parent].exchanged | candidate.group, candidate.group, candidate.parent, candidate.margin });
+            }
+        }
+
+        // Sequences reaching the same tanks with the same last step are interchangeable, so only the widest margin is kept
+        std::sort(next.begin(), next.end(), [](const Node& a, const Node& b) {
+            if (a.exchanged != b.exchanged) {
+                return a.exchanged < b.exchanged;
+            }
+            if (a.last != b.last) {
+                return a.last < b.last;
+            }
+            return a.margin > b.margin;
+            });
+        next.erase(std::unique(next.begin(), next.end(), [](const Node& a, const Node& b) {
+            return a.exchanged == b.exchanged && a.last == b.last;
+            }), next.end());
+
+        std::sort(next.begin(), next.end(), [](const Node& a, const Node& b) {
+            size_t countA = std::bitset<maxTanks>(a.exchanged).count();
+            size_t countB = std::bitset<maxTanks>(b.exchanged).count();
+            if (countA != countB) {
+                return countA > countB;
+            }
+            return a.margin > b.margin;
+            });
+        if (next.size() > beamWidth) {
+            next.resize(beamWidth);
+        }
+        // Completed sequences rank first, the one with the widest margin ahead of the others
+        found = !next.empty() && next.front().exchanged == all;
+        levels.push_back(std::move(next));
+    }
+
+    if (!found) {
+        return plan;
+    }
+
+    // Walk back from the completed sequence, then replay it to report the equilibria of every step
+    std::vector<uint64_t> sequence;
+    size_t index = 0;
+    for (size_t level = levels.size() - 1; level > 0; --level) {
+        const Node& node = levels[level][index];
+        sequence.push_back(node.last);
+        index = node.parent;
+    }
+    std::reverse(sequence.begin(), sequence.end());
+
+    plan.feasible = true;
+    plan.margin = levels.back().front().margin;
+    uint64_t previous = 0;
+    for (size_t s = 0; s <= sequence.size(); ++s) {
+        const uint64_t group = (s < sequence.size()) ? sequence[s] : 0;
+        ExchangeStep step;
+        step.refilled = tankNames(previous);
+        step.emptied = tankNames(group);
+        step.halfway = evaluate(0, previous | group, GM);
+        step.end = evaluate(group, 0, GM);
+        plan.steps.push_back(step);
+        previous = group;
+    }
+    return plan;
+}
+
+// Implementing the evaluate method
+ShipResults BallastExchangePlanner::evaluate(uint64_t empty, uint64_t half, double& GM) const {
+    double mass = displacement, longitudinal = longitudinalMoment, transverse = transverseMoment, vertical = verticalMoment;
+    double freeSurface = freeSurfaceMoment;
+    for (int pass = 0; pass < 2; ++pass) {
+        uint64_t mask = pass ? half : empty;
+        const std::vector<TankChange>& changes = pass ? halfChanges : emptyChanges;
+        for (size_t i = 0; mask != 0; ++i, mask >>= 1) {
+            if (mask & 1) {
+                const TankChange& change = changes[i];
+                mass += change.mass;
+                longitudinal += change.longitudinalMoment;
+                transverse += change.transverseMoment;
+                vertical += change.verticalMoment;
+                freeSurface += change.freeSurfaceMoment;
+            }
+        }
+    }
+    ShipResults results = Ship::solveEquilibrium(model, mass, longitudinal, transverse, vertical, precision);
+    GM = results.GM - freeSurface / mass;
+    return results;
+}
+
+// Implementing the margin method
+// Slack to each limit, relative to the limit, so that the limits weigh alike in the ranking of the beam
+double BallastExchangePlanner::margin(const ShipResults& results, double GM) const {
+    double slack = (limits.maxDraught - std::max(results.TF, results.TA)) / limits.maxDraught;
+    slack = std::min(slack, (limits.maxTrim - std::abs(results.trim)) / limits.maxTrim);
+    slack = std::min(slack, (limits.maxHeel - std::abs(results.heel)) / limits.maxHeel);
+    slack = std::min(slack, (GM - limits.minGM) / std::max(limits.minGM, 0.01));
+    if (limits.minForwardDraught > 0.0) {
+        slack = std::min(slack, (results.TF - limits.minForwardDraught) / limits.minForwardDraught);
+    }
+    return std::isnan(slack) ? -1.0 : slack;
+}
+
+// Implementing the tankNames method
+std::vector<std::string> BallastExchangePlanner::tankNames(uint64_t group) const {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < tanks.size(); ++i) {
+        if (group & (uint64_t(1) << i)) {
+            names.push_back(tanks[i]);
+        }
+    }
+    return names;
+}
\ No newline at end of file
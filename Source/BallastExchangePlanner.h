@@ -0,0 +1,96 @@
+#ifndef BALLASTEXCHANGEPLANNER_H
+#define BALLASTEXCHANGEPLANNER_H
+
+#include "Ship.h"
+#include "ShipModel.h"
+#include "WorkStealingPool.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+// Limits that every intermediate condition of a ballast water exchange must satisfy
+struct ExchangeLimits {
+    // Deepest of the forward and aft draughts [m]
+    double maxDraught = 18.0;
+    // Shallowest forward draught, e.g. against slamming [m]; zero disables the limit
+    double minForwardDraught = 0.0;
+    // Trim either way [m]
+    double maxTrim = 4.0;
+    // Metacentric height corrected for the free surfaces of the tanks [m]
+    double minGM = 0.15;
+    // Angle of heel either way [deg]
+    double maxHeel = 5.0;
+};
+
+// One step of the sequence: the tanks emptied in the previous step are refilled with ocean water while the next ones are emptied
+struct ExchangeStep {
+    std::vector<std::string> refilled;
+    std::vector<std::string> emptied;
+    // Equilibrium halfway through the step, with every tank being pumped half way, and at its end
+    ShipResults halfway, end;
+};
+
+struct ExchangePlan {
+    bool feasible;
+    std::vector<ExchangeStep> steps;
+    // Smallest relative slack to any limit along the sequence; negative if a limit is exceeded
+    double margin;
+    // Intermediate conditions evaluated by the search
+    size_t evaluations;
+};
+
+// Sequential ballast water exchange of the R2.* tanks of a loading condition
+// A beam search orders the tanks into groups of up to tanksPerStep, pumped together, and stops at the first depth
+// where every tank has been exchanged without exceeding a limit; the beam keeps the partial sequences that have
+// exchanged the most tanks, then those with the widest margin, so the sequence is the shortest the beam finds
+// Each intermediate condition is the loading condition plus the changes of at most two groups of tanks, precomputed
+// from the sounding tables, so an evaluation is a few additions and one hydrostatic interpolation
+class BallastExchangePlanner {
+public:
+    BallastExchangePlanner(const Ship& ship, const ExchangeLimits& limits = ExchangeLimits(), size_t tanksPerStep = 2, size_t beamWidth = 32);
+
+    // Ballast tanks holding water in the loading condition, in the order of their keys
+    const std::vector<std::string>& getTanks() const;
+
+    // Limits in force, after relaxing those the loading condition already exceeds to the condition itself
+    const ExchangeLimits& getLimits() const;
+
+    ExchangePlan plan(WorkStealingPool& pool) const;
+
+private:
+    static const size_t maxTanks = 64;
+
+    // Change of a tank from its fill in the loading condition, as summed by the ship
+    struct TankChange {
+        double mass, longitudinalMoment, transverseMoment, verticalMoment, freeSurfaceMoment;
+    };
+
+    // Partial sequence: the tanks exchanged so far, those of its last step, and its position in the previous beam
+    struct Node {
+        uint64_t exchanged;
+        uint64_t last;
+        size_t parent;
+        double margin;
+    };
+
+    const ShipModel& model;
+    // Precision of the ship, in which the equilibria of the search are solved
+    Precision precision;
+    ExchangeLimits limits;
+    size_t beamWidth;
+    double displacement, longitudinalMoment, transverseMoment, verticalMoment, freeSurfaceMoment;
+    std::vector<std::string> tanks;
+    std::vector<TankChange> emptyChanges, halfChanges;
+    // Every group of one to tanksPerStep tanks, as bit masks over tanks
+    std::vector<uint64_t> groups;
+
+    // Equilibrium with the tanks of empty emptied and those of half pumped half way; the corrected GM is returned through GM
+    ShipResults evaluate(uint64_t empty, uint64_t half, double& GM) const;
+
+    double margin(const ShipResults& results, double GM) const;
+
+    std::vector<std::string> tankNames(uint64_t group) const;
+};
+
+#endif // BALLASTEXCHANGEPLANNER_H
\ No newline at end of file
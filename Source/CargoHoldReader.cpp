@@ -26,15 +26,10 @@ bool CargoHoldReader::readFile(const std::string& cargoHold) {
             continue; // Skip empty lines
         }
         std::stringstream ss(line);
-        std::vector<double> row;
-        double value;
-        int columnCount = 0;
-        while (ss >> value) {
-            row.push_back(value);
-            columnCount++;
-        }
-        // Ensure each row has exactly 6 columns, as required by the form of the TXT files
-        if (columnCount == 6) {
+        CargoHoldSchema::Row row;
+        size_t columnCount = 0;
+        // Ensure each row has exactly the columns of the schema, as required by the form of the TXT files
+        if (readColumns<CargoHoldSchema>(ss, row, columnCount) && columnCount == CargoHoldSchema::columnCount) {
             cargoData.push_back(row);
         }
     }
@@ -44,7 +39,7 @@ bool CargoHoldReader::readFile(const std::string& cargoHold) {
 }
 
 // Implementing the getData method
-const std::vector<std::vector<double>>& CargoHoldReader::getData() const {
+const std::vector<CargoHoldSchema::Row>& CargoHoldReader::getData() const {
     return cargoData;
 }
 
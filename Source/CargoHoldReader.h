@@ -7,15 +7,16 @@
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include "TableSchemas.h"
 
 class CargoHoldReader {
 public:
     CargoHoldReader(const std::string& cargoHold);
     bool readFile(const std::string& cargoHold);
-    const std::vector<std::vector<double>>& getData() const;
+    const std::vector<CargoHoldSchema::Row>& getData() const;
 
 private:
-    std::vector<std::vector<double>> cargoData;
+    std::vector<CargoHoldSchema::Row> cargoData;
     std::string trim(const std::string& str) const;
 };
 
@@ -0,0 +1,140 @@
+#include "ConditionFileReader.h"
+
+// Implementing the constructor
+ConditionFileReader::ConditionFileReader(const std::string& fileName) {
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for reading.");
+    }
+    read(file, fileName);
+}
+
+// Implementing the constructor for a stream
+ConditionFileReader::ConditionFileReader(std::istream& input, const std::string& label) {
+    read(input, label);
+}
+
+// Implementing the getData method
+const std::vector<ConditionDefinition>& ConditionFileReader::getData() const {
+    return conditions;
+}
+
+// Implementing the read method
+void ConditionFileReader::read(std::istream& input, const std::string& label) {
+    // Filled compartments of every condition, which need the density of their group
+    std::vector<std::pair<size_t, std::string>> filled;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream stream(line);
+        std::string directive;
+        if (!(stream >> directive)) {
+            continue;
+        }
+        const std::string where = " on line " + std::to_string(lineNumber);
+
+        if (directive == "condition") {
+            ConditionDefinition condition;
+            if (!(stream >> condition.label)) {
+                throw std::runtime_error("Missing condition label" + where);
+            }
+            conditions.push_back(condition);
+            continue;
+        }
+        if (conditions.empty()) {
+            conditions.push_back(ConditionDefinition());
+            conditions.back().label = label;
+        }
+        ConditionDefinition& condition = conditions.back();
+
+        if (directive == "density") {
+            int group;
+            double density;
+            if (!(stream >> group >> density) || group < 1 || group > 9 || density <= 0.0) {
+                throw std::runtime_error("Invalid density" + where);
+            }
+            if (group > static_cast<int>(condition.densities.size())) {
+                condition.densities.resize(group, 0.0);
+            }
+            condition.densities[group - 1] = density;
+        }
+        else if (directive == "lightweight") {
+            double mass, lcg, tcg, vcg;
+            if (!(stream >> mass >> lcg >> tcg >> vcg)) {
+                throw std::runtime_error("Invalid lightweight" + where);
+            }
+            condition.tankPlan["Lightweight"] = { mass, lcg, tcg, vcg };
+        }
+        else if (directive == "fill") {
+            std::string key;
+            double fillPercentage;
+            if (!(stream >> key >> fillPercentage) || fillPercentage < 0.0 || fillPercentage > 100.0) {
+                throw std::runtime_error("Invalid fill" + where);
+            }
+            if (key.size() < 4 || key[0] != 'R' || !isdigit(key[1]) || key[2] != '.') {
+                throw std::runtime_error("Invalid compartment key " + key + where);
+            }
+            if (condition.tankPlan.count(key)) {
+                throw std::runtime_error("Compartment " + key + " is already defined in condition " + condition.label + where);
+            }
+            // Mass and centroids are interpolated from the tables; the book columns are kept for the layout only
+            condition.tankPlan[key] = { 0.0, fillPercentage, 0.0, 0.0, 0.0, 0.0 };
+            filled.push_back(std::make_pair(conditions.size() - 1, key));
+            condition.fills.push_back(key);
+        }
+        else if (directive == "item") {
+            // The name runs up to the first number
+            std::vector<std::string> tokens;
+            std::string token;
+            while (stream >> token) {
+                tokens.push_back(token);
+            }
+            size_t first = 0;
+            std::string name;
+            for (; first < tokens.size(); ++first) {
+                std::istringstream number(tokens[first]);
+                double value;
+                if (number >> value && number.eof()) {
+                    break;
+                }
+                name += (name.empty() ? "" : " ") + tokens[first];
+            }
+            std::vector<double> values;
+            for (size_t i = first; i < tokens.size(); ++i) {
+                std::istringstream number(tokens[i]);
+                double value;
+                if (!(number >> value) || !number.eof()) {
+                    throw std::runtime_error("Invalid item value " + tokens[i] + where);
+                }
+                values.push_back(value);
+            }
+            if (name.empty() || values.size() < 4 || values.size() > 5 || name == "Lightweight") {
+                throw std::runtime_error("Invalid item" + where);
+            }
+            // Cargo holds are always filled by percentage, and the Floating Condition entry is not a load
+            // Tanks with a sounding table are rejected once the ship model is known, by LoadingCondition::checkFills
+            if (name.compare(0, 3, "R1.") == 0 || name == "Floating Condition") {
+                throw std::runtime_error("Item name " + name + " is reserved" + where);
+            }
+            if (condition.tankPlan.count(name)) {
+                throw std::runtime_error("Item " + name + " is already defined in condition " + condition.label + where);
+            }
+            values.resize(5, 0.0);
+            condition.tankPlan[name] = { values[0], 0.0, values[1], values[2], values[3], values[4] };
+            condition.items.push_back(name);
+        }
+        else {
+            throw std::runtime_error("Unknown directive " + directive + where);
+        }
+    }
+
+    for (const auto& entry : filled) {
+        const ConditionDefinition& condition = conditions[entry.first];
+        size_t group = entry.second[1] - '0';
+        if (group < 1 || group > condition.densities.size() || condition.densities[group - 1] <= 0.0) {
+            throw std::runtime_error("No density for " + entry.second + " in condition " + condition.label);
+        }
+    }
+}
\ No newline at end of file
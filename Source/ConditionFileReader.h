@@ -0,0 +1,48 @@
+#ifndef CONDITIONFILEREADER_H
+#define CONDITIONFILEREADER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+// Loading condition defined outside the trim and stability book, in the layout LoadingCondition draws from the book
+struct ConditionDefinition {
+    std::string label;
+    std::unordered_map<std::string, std::vector<double>> tankPlan;
+    std::vector<double> densities;
+    // Keys given by fill directives, checked against the ship model when the condition is built; empty for conditions from other sources
+    std::vector<std::string> fills;
+    // Names given by item directives, checked in the same way
+    std::vector<std::string> items;
+};
+
+// Reads loading conditions from a plain text file, so that ad-hoc conditions need no pass over the book
+// One directive per line; blank lines and text after '#' are ignored:
+//   condition <label>                              starts a new condition
+//   density <group> <t/m3>                         density of the contents of the group, the digit after 'R' in the keys
+//   lightweight <mass> <lcg> <tcg> <vcg>
+//   fill <key> <percentage>                        tank with a sounding table, or cargo hold R1.1 to R1.9
+//   item <name> <mass> <lcg> <tcg> <vcg> [fsm]     deadweight item, e.g. crew and stores; the name may contain spaces,
+//                                                  or be the key of a compartment without a sounding table, e.g. R5.1
+// A key or name may be defined only once per condition; items may not name cargo holds, tanks with a sounding table
+// or "Floating Condition"
+// Directives before the first "condition" line belong to a condition labelled after the file
+class ConditionFileReader {
+public:
+    explicit ConditionFileReader(const std::string& fileName);
+
+    ConditionFileReader(std::istream& input, const std::string& label);
+
+    const std::vector<ConditionDefinition>& getData() const;
+
+private:
+    std::vector<ConditionDefinition> conditions;
+
+    void read(std::istream& input, const std::string& label);
+};
+
+#endif // CONDITIONFILEREADER_H
\ No newline at end of file
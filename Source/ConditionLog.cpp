@@ -0,0 +1,495 @@
+#include "ConditionLog.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+    const char logMagic[8] = { 'L', 'D', 'R', 'C', 'N', 'L', 'O', 'G' };
+    const size_t headerSize = sizeof(logMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+    // Sync word, payload length and CRC-32 of the payload
+    const uint32_t frameSync = 0x474F4C43;
+    const size_t frameHeaderSize = 3 * sizeof(uint32_t);
+    const uint32_t maximumPayload = 1u << 24;
+    const uint64_t keyframeFlag = 1;
+    const uint64_t singlePrecisionFlag = 2;
+    // Values that are exact multiples of 1 / valueScale, as fills and most book values are, are written as varint differences
+    const double valueScale = 1e4;
+
+    static_assert(sizeof(ShipResults) == 15 * sizeof(double), "Padded ShipResults.");
+
+    // CRC-32 (IEEE 802.3), byte at a time
+    uint32_t crc32(const char* data, size_t length) {
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> entries;
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                }
+                entries[i] = crc;
+            }
+            return entries;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < length; ++i) {
+            crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    void putVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // Whether the value is exactly the multiple of 1 / valueScale that is returned, negative zero excepted
+    bool scaled(double value, int64_t& multiple) {
+        if (!(std::fabs(value) < 1e12) || (value == 0.0 && std::signbit(value))) {
+            return false;
+        }
+        multiple = std::llround(value * valueScale);
+        return static_cast<double>(multiple) / valueScale == value;
+    }
+
+    // Tag 0: unchanged; tag 1 in the two low bits: difference of the multiples; tag 2: the raw value follows
+    void putValue(std::string& out, double value, double previous) {
+        if (std::memcmp(&value, &previous, sizeof(double)) == 0) {
+            out.push_back(0);
+            return;
+        }
+        int64_t multiple, previousMultiple;
+        if (scaled(value, multiple)) {
+            if (!scaled(previous, previousMultiple)) {
+                previousMultiple = 0;
+            }
+            putVarint(out, (zigzag(multiple - previousMultiple) << 2) | 1);
+            return;
+        }
+        out.push_back(2);
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    bool sameValues(const std::vector<double>& a, const std::vector<double>& b) {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+    }
+
+    // Bounds-checked reading of a payload; malformed payloads throw
+    struct Cursor {
+        const char* data;
+        size_t size, position;
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (position >= size) {
+                    throw std::runtime_error("Truncated varint.");
+                }
+                const unsigned char byte = static_cast<unsigned char>(data[position++]);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Overlong varint.");
+        }
+
+        void bytes(void* out, size_t length) {
+            if (length > size - position) {
+                throw std::runtime_error("Truncated record.");
+            }
+            std::memcpy(out, data + position, length);
+            position += length;
+        }
+
+        std::string string() {
+            const uint64_t length = varint();
+            if (length > size - position) {
+                throw std::runtime_error("Truncated string.");
+            }
+            std::string value(data + position, static_cast<size_t>(length));
+            position += static_cast<size_t>(length);
+            return value;
+        }
+
+        double value(double previous) {
+            const uint64_t tag = varint();
+            if (tag == 0) {
+                return previous;
+            }
+            if ((tag & 3) == 1) {
+                int64_t previousMultiple;
+                if (!scaled(previous, previousMultiple)) {
+                    previousMultiple = 0;
+                }
+                return static_cast<double>(previousMultiple + unzigzag(tag >> 2)) / valueScale;
+            }
+            if (tag == 2) {
+                double value;
+                bytes(&value, sizeof(value));
+                return value;
+            }
+            throw std::runtime_error("Unknown value tag.");
+        }
+    };
+
+    // Largest absolute difference between the fields of two results; a NaN on one side only is an infinite difference
+    double deviation(const ShipResults& a, const ShipResults& b) {
+        static const double ShipResults::* const fields[] = { &ShipResults::displacement, &ShipResults::LCG, &ShipResults::TCG, &ShipResults::VCG,
+            &ShipResults::draughtMoulded, &ShipResults::LCF, &ShipResults::LCB, &ShipResults::VCB, &ShipResults::KMT, &ShipResults::MCT,
+            &ShipResults::trim, &ShipResults::GM, &ShipResults::heel, &ShipResults::TF, &ShipResults::TA };
+        double largest = 0.0;
+        for (const double ShipResults::* field : fields) {
+            const double x = a.*field, y = b.*field;
+            if (std::isnan(x) || std::isnan(y)) {
+                if (std::isnan(x) != std::isnan(y)) {
+                    return std::numeric_limits<double>::infinity();
+                }
+                continue;
+            }
+            largest = std::max(largest, std::fabs(x - y));
+        }
+        return largest;
+    }
+}
+
+// Implementing the constructor
+ConditionLog::ConditionLog(const std::string& fileName, const ShipModel& model, size_t keyframeInterval)
+    : ConditionLog(fileName, model.getFingerprint(), keyframeInterval) {
+}
+
+// Implementing the constructor for a fingerprint
+ConditionLog::ConditionLog(const std::string& fileName, uint64_t fingerprint, size_t keyframeInterval)
+    : keyframeInterval(std::max<size_t>(keyframeInterval, 1)), recordCount(0), previousTimestamp(0),
+    recordsSinceKeyframe(std::max<size_t>(keyframeInterval, 1)) {
+    const uint32_t version = fileVersion;
+    std::ifstream existing(fileName, std::ios::binary);
+    const bool empty = !existing.is_open() || existing.peek() == std::ifstream::traits_type::eof();
+    if (!empty) {
+        char magic[sizeof(logMagic)];
+        uint32_t existingVersion;
+        uint64_t existingFingerprint;
+        if (!existing.read(magic, sizeof(magic)) || std::memcmp(magic, logMagic, sizeof(logMagic)) != 0
+            || !existing.read(reinterpret_cast<char*>(&existingVersion), sizeof(existingVersion)) || existingVersion != version
+            || !existing.read(reinterpret_cast<char*>(&existingFingerprint), sizeof(existingFingerprint))) {
+            throw std::runtime_error(fileName + " is not a condition log of this version.");
+        }
+        if (existingFingerprint != fingerprint) {
+            throw std::runtime_error(fileName + " was recorded with other ship data.");
+        }
+    }
+    existing.close();
+
+    file.open(fileName, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for writing.");
+    }
+    if (empty) {
+        file.write(logMagic, sizeof(logMagic));
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+    }
+}
+
+// Implementing the append method
+void ConditionLog::append(const ConditionDefinition& definition, Precision precision, const ShipResults& results) {
+    const uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::lock_guard<std::mutex> lock(mutex);
+    try {
+        encode(definition, precision, results, timestamp);
+    }
+    catch (...) {
+        // The state has been moved on to a record the file may not hold, so the next record is written against an empty state
+        recordsSinceKeyframe = keyframeInterval;
+        throw;
+    }
+    previousTimestamp = timestamp;
+    ++recordsSinceKeyframe;
+    ++recordCount;
+}
+
+// Implementing the encode method
+void ConditionLog::encode(const ConditionDefinition& definition, Precision precision, const ShipResults& results, uint64_t timestamp) {
+    const bool keyframe = recordsSinceKeyframe >= keyframeInterval;
+    if (keyframe) {
+        previousPlan.clear();
+        previousDensities.clear();
+        keyIds.clear();
+        previousTimestamp = 0;
+        recordsSinceKeyframe = 0;
+    }
+    payload.clear();
+    putVarint(payload, (keyframe ? keyframeFlag : 0) | (precision == Precision::Single ? singlePrecisionFlag : 0));
+    putVarint(payload, zigzag(static_cast<int64_t>(timestamp - previousTimestamp)));
+    putVarint(payload, definition.label.size());
+    payload.append(definition.label);
+
+    putVarint(payload, definition.densities.size());
+    for (size_t i = 0; i < definition.densities.size(); ++i) {
+        putValue(payload, definition.densities[i], i < previousDensities.size() ? previousDensities[i] : 0.0);
+    }
+    previousDensities = definition.densities;
+
+    // Compartments of the previous record missing from this one
+    size_t removed = 0;
+    for (const auto& pair : previousPlan) {
+        if (definition.tankPlan.find(pair.first) == definition.tankPlan.end()) {
+            ++removed;
+        }
+    }
+    putVarint(payload, removed);
+    for (auto it = previousPlan.begin(); it != previousPlan.end();) {
+        if (definition.tankPlan.find(it->first) == definition.tankPlan.end()) {
+            putVarint(payload, keyIds.at(it->first));
+            it = previousPlan.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Compartments added or changed since the previous record, the values encoded against the previous ones
+    size_t changed = 0;
+    for (const auto& pair : definition.tankPlan) {
+        auto previous = previousPlan.find(pair.first);
+        if (previous == previousPlan.end() || !sameValues(previous->second, pair.second)) {
+            ++changed;
+        }
+    }
+    putVarint(payload, changed);
+    for (const auto& pair : definition.tankPlan) {
+        auto previous = previousPlan.find(pair.first);
+        if (previous != previousPlan.end() && sameValues(previous->second, pair.second)) {
+            continue;
+        }
+        auto id = keyIds.find(pair.first);
+        if (id == keyIds.end()) {
+            putVarint(payload, 0);
+            putVarint(payload, pair.first.size());
+            payload.append(pair.first);
+            const uint64_t newId = keyIds.size();
+            keyIds.emplace(pair.first, newId);
+        }
+        else {
+            putVarint(payload, id->second + 1);
+        }
+        const std::vector<double>& values = pair.second;
+        putVarint(payload, values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            const bool hasPrevious = previous != previousPlan.end() && i < previous->second.size();
+            putValue(payload, values[i], hasPrevious ? previous->second[i] : 0.0);
+        }
+        if (previous == previousPlan.end()) {
+            previousPlan.emplace(pair.first, values);
+        }
+        else {
+            previous->second = values;
+        }
+    }
+
+    payload.append(reinterpret_cast<const char*>(&results), sizeof(results));
+    if (payload.size() > maximumPayload) {
+        throw std::runtime_error("Condition too large for the log: " + definition.label);
+    }
+
+    const uint32_t frame[3] = { frameSync, static_cast<uint32_t>(payload.size()), crc32(payload.data(), payload.size()) };
+    file.write(reinterpret_cast<const char*>(frame), sizeof(frame));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to append to the condition log.");
+    }
+}
+
+// Implementing the flush method
+void ConditionLog::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    file.flush();
+}
+
+// Implementing the getRecordCount method
+size_t ConditionLog::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recordCount;
+}
+
+// Implementing the read method
+LogReadStatistics ConditionLog::read(const std::string& fileName, std::vector<LoggedCondition>& records) {
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for reading.");
+    }
+    const size_t size = static_cast<size_t>(file.tellg());
+    std::vector<char> data(size);
+    file.seekg(0);
+    if (size > 0 && !file.read(data.data(), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("Failed to read " + fileName);
+    }
+
+    LogReadStatistics statistics = { 0, 0, 0, 0 };
+    uint32_t version;
+    if (size < headerSize || std::memcmp(data.data(), logMagic, sizeof(logMagic)) != 0) {
+        throw std::runtime_error(fileName + " is not a condition log.");
+    }
+    std::memcpy(&version, data.data() + sizeof(logMagic), sizeof(version));
+    std::memcpy(&statistics.fingerprint, data.data() + sizeof(logMagic) + sizeof(version), sizeof(statistics.fingerprint));
+    if (version != fileVersion) {
+        throw std::runtime_error(fileName + " is a condition log of another version.");
+    }
+
+    // State the records are decoded against; it is valid once a keyframe has been read since the last damaged frame
+    ConditionDefinition current;
+    std::vector<std::string> dictionary;
+    uint64_t timestamp = 0;
+    bool synchronized = false;
+
+    size_t position = headerSize;
+    while (position < size) {
+        uint32_t frame[3] = { 0, 0, 0 };
+        bool intact = size - position >= frameHeaderSize;
+        if (intact) {
+            std::memcpy(frame, data.data() + position, sizeof(frame));
+            intact = frame[0] == frameSync && frame[1] <= maximumPayload && frame[1] <= size - position - frameHeaderSize
+                && crc32(data.data() + position + frameHeaderSize, frame[1]) == frame[2];
+        }
+        if (!intact) {
+            // Resynchronizes on the next sync word; the records up to the next keyframe cannot be decoded
+            ++statistics.corrupt;
+            synchronized = false;
+            ++position;
+            while (position + sizeof(frameSync) <= size && std::memcmp(data.data() + position, &frameSync, sizeof(frameSync)) != 0) {
+                ++position;
+            }
+            if (position + sizeof(frameSync) > size) {
+                break;
+            }
+            continue;
+        }
+
+        Cursor cursor = { data.data() + position + frameHeaderSize, frame[1], 0 };
+        position += frameHeaderSize + frame[1];
+        try {
+            const uint64_t flags = cursor.varint();
+            if (!(flags & keyframeFlag) && !synchronized) {
+                ++statistics.skipped;
+                continue;
+            }
+            if (flags & keyframeFlag) {
+                current.tankPlan.clear();
+                current.densities.clear();
+                dictionary.clear();
+                timestamp = 0;
+            }
+            synchronized = false;
+            timestamp += static_cast<uint64_t>(unzigzag(cursor.varint()));
+            current.label = cursor.string();
+
+            const uint64_t densityCount = cursor.varint();
+            if (densityCount > frame[1]) {
+                throw std::runtime_error("Invalid density count.");
+            }
+            // Values beyond the previous count are decoded against zero, as they were encoded
+            current.densities.resize(static_cast<size_t>(densityCount), 0.0);
+            for (double& density : current.densities) {
+                density = cursor.value(density);
+            }
+            const uint64_t removed = cursor.varint();
+            for (uint64_t i = 0; i < removed; ++i) {
+                const uint64_t id = cursor.varint();
+                if (id >= dictionary.size()) {
+                    throw std::runtime_error("Unknown compartment.");
+                }
+                current.tankPlan.erase(dictionary[static_cast<size_t>(id)]);
+            }
+            const uint64_t changed = cursor.varint();
+            for (uint64_t i = 0; i < changed; ++i) {
+                const uint64_t reference = cursor.varint();
+                if (reference == 0) {
+                    dictionary.push_back(cursor.string());
+                }
+                else if (reference > dictionary.size()) {
+                    throw std::runtime_error("Unknown compartment.");
+                }
+                const std::string& key = dictionary[static_cast<size_t>(reference == 0 ? dictionary.size() - 1 : reference - 1)];
+                const uint64_t valueCount = cursor.varint();
+                if (valueCount > frame[1]) {
+                    throw std::runtime_error("Invalid value count.");
+                }
+                std::vector<double>& values = current.tankPlan[key];
+                values.resize(static_cast<size_t>(valueCount), 0.0);
+                for (double& value : values) {
+                    value = cursor.value(value);
+                }
+            }
+
+            LoggedCondition record;
+            cursor.bytes(&record.results, sizeof(record.results));
+            if (cursor.position != cursor.size) {
+                throw std::runtime_error("Trailing bytes in record.");
+            }
+            record.timestamp = timestamp;
+            record.definition = current;
+            record.precision = (flags & singlePrecisionFlag) ? Precision::Single : Precision::Double;
+            records.push_back(std::move(record));
+            ++statistics.records;
+            synchronized = true;
+        }
+        catch (const std::runtime_error&) {
+            ++statistics.corrupt;
+        }
+    }
+    return statistics;
+}
+
+// Implementing the replay method
+ReplayReport ConditionLog::replay(std::shared_ptr<const ShipModel> model, const std::string& fileName, WorkStealingPool& pool, double tolerance) {
+    ReplayReport report;
+    std::vector<LoggedCondition> records;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    report.read = read(fileName, records);
+    report.decodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (report.read.fingerprint != model->getFingerprint()) {
+        throw std::runtime_error(fileName + " was recorded with other ship data.");
+    }
+
+    // A condition that can no longer be evaluated counts as a mismatch rather than stopping the replay
+    std::vector<double> deviations(records.size());
+    start = std::chrono::steady_clock::now();
+    pool.parallelFor(records.size(), [&](size_t i) {
+        try {
+            Ship ship(model, records[i].definition);
+            if (records[i].precision == Precision::Single) {
+                ship.setPrecision(Precision::Single);
+            }
+            deviations[i] = deviation(ship.getResults(), records[i].results);
+        }
+        catch (const std::exception&) {
+            deviations[i] = std::numeric_limits<double>::infinity();
+        }
+        }, 16);
+    report.evaluateTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.recordsPerSecond = report.evaluateTime > 0.0 ? records.size() / report.evaluateTime : 0.0;
+    report.threadCount = pool.getThreadCount();
+
+    report.maxDeviation = 0.0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        report.maxDeviation = std::max(report.maxDeviation, deviations[i]);
+        if (!(deviations[i] <= tolerance)) {
+            report.mismatches.push_back({ i, records[i].definition.label, deviations[i] });
+        }
+    }
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef CONDITIONLOG_H
+#define CONDITIONLOG_H
+
+#include "Ship.h"
+#include "ShipModel.h"
+#include "ConditionFileReader.h"
+#include "WorkStealingPool.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <cstdint>
+#include <stdexcept>
+
+struct LoggedCondition {
+    // Microseconds since the epoch, when the record was appended
+    uint64_t timestamp;
+    ConditionDefinition definition;
+    Precision precision;
+    ShipResults results;
+};
+
+struct LogReadStatistics {
+    uint64_t fingerprint;
+    size_t records;
+    // Frames failing their checksum or framing, and intact records dropped because the record they were encoded against was lost
+    size_t corrupt, skipped;
+};
+
+struct ReplayMismatch {
+    size_t record;
+    std::string label;
+    // Largest absolute difference over the fields of ShipResults
+    double deviation;
+};
+
+struct ReplayReport {
+    LogReadStatistics read;
+    std::vector<ReplayMismatch> mismatches;
+    double maxDeviation;
+    // Elapsed times of decoding the log and of re-evaluating its records [s]
+    double decodeTime, evaluateTime;
+    double recordsPerSecond;
+    size_t threadCount;
+};
+
+// Append-only binary log of the conditions evaluated by the planning tools and of the results Ship produced for them
+// The file starts with a header holding the fingerprint of the ship model; every record is framed by a sync word,
+// its length and the CRC-32 of its payload, so that a reader skips a damaged or truncated record and resynchronizes on the next frame
+// Compartments are encoded against the previous record: only changed, added and removed entries are written, keys as indices into
+// a dictionary, and values as varints, either unchanged, as the difference of their multiples of 1e-4, or raw when not such a multiple
+// Every keyframeInterval records, and first after opening, a record is written against an empty state,
+// so that a reader loses at most the records up to the next keyframe after a damaged frame
+class ConditionLog {
+public:
+    // Appends to the file, which is created if it does not exist; a file written for another ship model is refused
+    ConditionLog(const std::string& fileName, const ShipModel& model, size_t keyframeInterval = 256);
+
+    // Log for a ship model known by its fingerprint only
+    ConditionLog(const std::string& fileName, uint64_t fingerprint, size_t keyframeInterval = 256);
+
+    ConditionLog(const ConditionLog&) = delete;
+    ConditionLog& operator=(const ConditionLog&) = delete;
+
+    // Safe to call from several threads; records are written in the order of the calls
+    void append(const ConditionDefinition& definition, Precision precision, const ShipResults& results);
+
+    void flush();
+
+    size_t getRecordCount() const;
+
+    // Decodes every intact record of the file
+    static LogReadStatistics read(const std::string& fileName, std::vector<LoggedCondition>& records);
+
+    // Re-evaluates every record with the model, in parallel over the pool, and compares the results with the logged ones
+    static ReplayReport replay(std::shared_ptr<const ShipModel> model, const std::string& fileName, WorkStealingPool& pool, double tolerance = 1e-9);
+
+private:
+    static const uint32_t fileVersion = 1;
+
+    std::ofstream file;
+    size_t keyframeInterval;
+    size_t recordCount;
+    mutable std::mutex mutex;
+
+    // State the next record is encoded against
+    std::unordered_map<std::string, std::vector<double>> previousPlan;
+    std::vector<double> previousDensities;
+    std::unordered_map<std::string, uint64_t> keyIds;
+    uint64_t previousTimestamp;
+    size_t recordsSinceKeyframe;
+    // Payload of the record being written, reused from record to record
+    std::string payload;
+
+    // Encodes the record against the state, moving the state on to it, and writes its frame
+    void encode(const ConditionDefinition& definition, Precision precision, const ShipResults& results, uint64_t timestamp);
+};
+
+#endif // CONDITIONLOG_H
\ No newline at end of file
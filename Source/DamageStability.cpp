@@ -0,0 +1,242 @@
+#include "DamageStability.h"
+#include <algorithm>
+#include <cmath>
+
+// Implementing the constructor
+DamageStability::DamageStability(const ShipModel& model, const Permeabilities& permeabilities)
+    : model(model), permeabilities(permeabilities) {
+    for (const std::string& key : model.getSoundingKeys()) {
+        addCompartment<SoundingTableSchema, SoundingTableSchema::IMOM>(key, false, model.getSoundingTable(key), 0.01);
+    }
+    for (int holdNumber = 1; holdNumber <= ShipModel::holdCount; ++holdNumber) {
+        addCompartment<CargoHoldSchema, CargoHoldSchema::FSM>("R1." + std::to_string(holdNumber), true, model.getCargoHold(holdNumber), 1.0);
+    }
+}
+
+// Implementing the getCompartments method
+const std::vector<std::string>& DamageStability::getCompartments() const {
+    return compartments;
+}
+
+// Implementing the scenarioMatrix method
+std::vector<std::vector<size_t>> DamageStability::scenarioMatrix(double adjacencyDistance) const {
+    std::vector<std::vector<size_t>> scenarios;
+    for (size_t i = 0; i < compartments.size(); ++i) {
+        scenarios.push_back({ i });
+    }
+    for (size_t i = 0; i < compartments.size(); ++i) {
+        for (size_t j = i + 1; j < compartments.size(); ++j) {
+            if (std::abs(fullLcg[i] - fullLcg[j]) <= adjacencyDistance) {
+                scenarios.push_back({ i, j });
+            }
+        }
+    }
+    return scenarios;
+}
+
+// Implementing the evaluate method
+DamageResult DamageStability::evaluate(const Ship& ship, const std::vector<size_t>& flooded, DamageMethod method) const {
+    DamageResult damage;
+    damage.condition = 0;
+    damage.iterations = 0;
+    damage.converged = false;
+    damage.floodedVolume = 0.0;
+    for (size_t k : flooded) {
+        if (k >= compartments.size()) {
+            throw std::out_of_range("Non-existent compartment in damage scenario.");
+        }
+        damage.scenario += (damage.scenario.empty() ? "" : "+") + compartments[k];
+    }
+
+    // Intact totals, less the contents that breached tanks lose to the sea
+    double displacement, longitudinalMoment, transverseMoment, verticalMoment;
+    std::tie(displacement, longitudinalMoment, transverseMoment, verticalMoment) = ship.getMoments();
+    std::vector<double> permeability(flooded.size());
+    for (size_t n = 0; n < flooded.size(); ++n) {
+        const size_t k = flooded[n];
+        auto it = ship.getCompartments().find(compartments[k]);
+        double mass = 0.0, lcg = 0.0, tcg = 0.0, vcg = 0.0, fsm = 0.0;
+        if (it != ship.getCompartments().end()) {
+            std::tie(mass, lcg, tcg, vcg, fsm) = it->second;
+        }
+        if (holds[k]) {
+            permeability[n] = (mass > 0.0) ? permeabilities.loadedHolds : permeabilities.emptyHolds;
+        }
+        else {
+            permeability[n] = permeabilities.tanks;
+            displacement -= mass;
+            longitudinalMoment -= mass * lcg;
+            transverseMoment -= mass * tcg + fsm;
+            verticalMoment -= mass * vcg;
+        }
+    }
+
+    // Equilibria are solved in the precision of the ship; the compartment tables of the damage model are interpolated in double
+    const Precision precision = ship.getLoadingCondition().getPrecision();
+    ShipResults results = ship.getResults();
+    while (damage.iterations < maxIterations && !damage.converged) {
+        ++damage.iterations;
+
+        // Floodwater rises to the outside waterline at the compartment, given the current draughts and heel
+        // Positive heel lowers the side with positive TCG, following the sign of the heeling moment
+        double volume = 0.0, longitudinal = 0.0, transverse = 0.0, vertical = 0.0, inertia = 0.0, lostInertia = 0.0;
+        const double heelSlope = std::tan(results.heel * M_PI / 180);
+        for (size_t n = 0; n < flooded.size(); ++n) {
+            const size_t k = flooded[n];
+            const double level = results.TA + (results.TF - results.TA) * fullLcg[k] / lengthBetweenPerpendiculars + fullTcg[k] * heelSlope;
+            double v, lcg, tcg, vcg, i, a;
+            interpolate(k, level, v, lcg, tcg, vcg, i, a);
+            v *= permeability[n];
+            volume += v;
+            longitudinal += v * lcg;
+            transverse += v * tcg;
+            vertical += v * vcg;
+            inertia += permeability[n] * i;
+            // About the centreline of the ship, rather than the centroid of the free surface
+            lostInertia += permeability[n] * (i + a * tcg * tcg);
+        }
+
+        ShipResults next;
+        if (method == DamageMethod::AddedWeight) {
+            // Free surface moments of the floodwater follow the convention of the intact condition
+            next = Ship::solveEquilibrium(model, displacement + seaWaterDensity * volume,
+                longitudinalMoment + seaWaterDensity * longitudinal,
+                transverseMoment + seaWaterDensity * (transverse + inertia),
+                verticalMoment + seaWaterDensity * vertical, precision);
+        }
+        else {
+            // The intact hull at the displacement including the lost volume supplies the draught,
+            // from which the lost volume, its centroid and its waterplane inertia are taken away
+            const double equivalentDisplacement = displacement + seaWaterDensity * volume;
+            double LCF, LCB, VCB, KMT, MCT;
+            next.displacement = displacement;
+            std::tie(next.draughtMoulded, LCF, LCB, VCB, KMT, MCT) = model.interpolateHydrostatics(equivalentDisplacement, precision);
+            next.LCF = LCF;
+            next.MCT = MCT;
+            next.LCB = (equivalentDisplacement * LCB - seaWaterDensity * longitudinal) / displacement;
+            next.VCB = (equivalentDisplacement * VCB - seaWaterDensity * vertical) / displacement;
+            next.KMT = next.VCB + ((KMT - VCB) * equivalentDisplacement - seaWaterDensity * lostInertia) / displacement;
+            const double TCB = -seaWaterDensity * transverse / displacement;
+
+            next.LCG = longitudinalMoment / displacement;
+            next.TCG = transverseMoment / displacement;
+            next.VCG = verticalMoment / displacement;
+            next.trim = displacement * (next.LCB - next.LCG) / (100 * next.MCT);
+            next.GM = next.KMT - next.VCG;
+            next.heel = std::atan((next.TCG - TCB) / next.GM) * 180 / M_PI;
+            next.TF = next.draughtMoulded - 0.5 * next.trim;
+            next.TA = next.draughtMoulded + 0.5 * next.trim;
+        }
+
+        damage.converged = std::abs(next.TF - results.TF) < tolerance && std::abs(next.TA - results.TA) < tolerance
+            && std::abs(next.heel - results.heel) < tolerance;
+        damage.floodedVolume = volume;
+        results = next;
+    }
+    damage.results = results;
+
+    return damage;
+}
+
+// Implementing the run method
+std::vector<DamageResult> DamageStability::run(const std::vector<const Ship*>& ships, const std::vector<std::vector<size_t>>& scenarios,
+    DamageMethod method, WorkStealingPool& pool) const {
+    std::vector<DamageResult> damages(ships.size() * scenarios.size());
+    pool.parallelFor(damages.size(), [&](size_t i) {
+        const size_t condition = i / scenarios.size();
+        damages[i] = evaluate(*ships[condition], scenarios[i % scenarios.size()], method);
+        damages[i].condition = condition;
+        }, 16);
+    return damages;
+}
+
+// Implementing the addCompartment method
+// Rows that break the ordering of sounding or volume are misread lines and are skipped
+// The bottom of the compartment is placed half the first sounding below the centroid of the first non-empty row
+template <class Schema, class Inertia>
+void DamageStability::addCompartment(const std::string& key, bool hold, TableView<Schema> rows, double soundingScale) {
+    const size_t offset = levelColumn.size();
+    double bottom = 0.0;
+    bool bottomFound = false;
+    for (size_t r = 0; r < rows.size(); ++r) {
+        const double* row = rows[r];
+        const double sounding = row[Schema::Sounding::index] * soundingScale;
+        const double volume = row[Schema::Volume::index];
+        if (!bottomFound) {
+            if (sounding <= 0.0 || volume <= 0.0) {
+                continue;
+            }
+            bottom = row[Schema::VCG::index] - 0.5 * sounding;
+            bottomFound = true;
+            // The first row of the compartment is rebuilt from the bottom, so that a dry compartment holds no volume
+            levelColumn.push_back(bottom);
+            volumeColumn.push_back(0.0);
+            lcgColumn.push_back(row[Schema::LCG::index]);
+            tcgColumn.push_back(row[Schema::TCG::index]);
+            vcgColumn.push_back(bottom);
+            inertiaColumn.push_back(0.0);
+        }
+        if (bottom + sounding <= levelColumn.back() || volume < volumeColumn.back()) {
+            continue;
+        }
+        levelColumn.push_back(bottom + sounding);
+        volumeColumn.push_back(volume);
+        lcgColumn.push_back(row[Schema::LCG::index]);
+        tcgColumn.push_back(row[Schema::TCG::index]);
+        vcgColumn.push_back(row[Schema::VCG::index]);
+        inertiaColumn.push_back(std::max(row[Inertia::index], 0.0));
+    }
+
+    // Compartments without two usable rows cannot be flooded
+    const size_t rowCount = levelColumn.size() - offset;
+    if (rowCount < 2) {
+        levelColumn.resize(offset);
+        volumeColumn.resize(offset);
+        lcgColumn.resize(offset);
+        tcgColumn.resize(offset);
+        vcgColumn.resize(offset);
+        inertiaColumn.resize(offset);
+        return;
+    }
+
+    // Waterplane area of every row, from the change of volume between the rows on either side
+    for (size_t r = offset; r < levelColumn.size(); ++r) {
+        const size_t below = (r > offset) ? r - 1 : r;
+        const size_t above = (r + 1 < levelColumn.size()) ? r + 1 : r;
+        areaColumn.push_back((volumeColumn[above] - volumeColumn[below]) / (levelColumn[above] - levelColumn[below]));
+    }
+
+    compartments.push_back(key);
+    holds.push_back(hold);
+    offsets.push_back(offset);
+    rowCounts.push_back(rowCount);
+    fullLcg.push_back(lcgColumn.back());
+    fullTcg.push_back(tcgColumn.back());
+}
+
+// Implementing the interpolate method
+// Levels below the bottom leave the compartment dry; levels above the top flood it completely, with no free surface
+void DamageStability::interpolate(size_t k, double level, double& volume, double& lcg, double& tcg, double& vcg, double& inertia,
+    double& area) const {
+    const double* levels = levelColumn.data() + offsets[k];
+    const size_t rowCount = rowCounts[k];
+    if (level >= levels[rowCount - 1]) {
+        const size_t r = offsets[k] + rowCount - 1;
+        volume = volumeColumn[r];
+        lcg = lcgColumn[r];
+        tcg = tcgColumn[r];
+        vcg = vcgColumn[r];
+        inertia = 0.0;
+        area = 0.0;
+        return;
+    }
+    level = std::max(level, levels[0]);
+    const size_t i = offsets[k] + static_cast<size_t>(std::upper_bound(levels + 1, levels + rowCount - 1, level) - levels) - 1;
+    const double fraction = (level - levelColumn[i]) / (levelColumn[i + 1] - levelColumn[i]);
+    volume = volumeColumn[i] + fraction * (volumeColumn[i + 1] - volumeColumn[i]);
+    lcg = lcgColumn[i] + fraction * (lcgColumn[i + 1] - lcgColumn[i]);
+    tcg = tcgColumn[i] + fraction * (tcgColumn[i + 1] - tcgColumn[i]);
+    vcg = vcgColumn[i] + fraction * (vcgColumn[i + 1] - vcgColumn[i]);
+    inertia = inertiaColumn[i] + fraction * (inertiaColumn[i + 1] - inertiaColumn[i]);
+    area = areaColumn[i] + fraction * (areaColumn[i + 1] - areaColumn[i]);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef DAMAGESTABILITY_H
+#define DAMAGESTABILITY_H
+
+#include "Ship.h"
+#include "ShipModel.h"
+#include "WorkStealingPool.h"
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// Lost buoyancy keeps the displacement and removes the flooded volume from the buoyant hull;
+// added weight treats the floodwater as a load of sea water
+enum class DamageMethod {
+    LostBuoyancy,
+    AddedWeight
+};
+
+// Fractions of the compartment volumes that can be taken up by floodwater
+struct Permeabilities {
+    double tanks = 0.95;
+    double loadedHolds = 0.70;
+    double emptyHolds = 0.95;
+};
+
+// Final equilibrium of one damage scenario of one loading condition
+struct DamageResult {
+    size_t condition;
+    std::string scenario;
+    ShipResults results;
+    // Permeable volume taken up by floodwater [m3]
+    double floodedVolume;
+    int iterations;
+    bool converged;
+};
+
+// Damage stability of single compartments and of adjacent pairs, for any number of loading conditions
+// The sounding tables and the cargo hold files give the volume and centroids of each compartment up to the outside waterline,
+// which is found iteratively from the draughts, trim and heel of the damaged ship
+// Tanks lose their contents to the sea; cargo stays in a flooded hold, taking up the part of its volume that is not permeable
+// With lost buoyancy, the transverse inertia of the lost waterplane is that of its free surface, i, plus a * tcg^2 about the centreline,
+// a being the waterplane area, taken as dV/dlevel of the tables; left out are the shift of the centroid of the remaining waterplane
+// off the centreline, and the change of LCF and MCT
+class DamageStability {
+public:
+    DamageStability(const ShipModel& model, const Permeabilities& permeabilities = Permeabilities());
+
+    // Tanks with a sounding table, then the cargo holds as "R1.1" to "R1.9"
+    const std::vector<std::string>& getCompartments() const;
+
+    // Every compartment on its own, then every pair of compartments whose full volume LCGs lie within adjacencyDistance [m]
+    // Scenarios hold indices into getCompartments()
+    std::vector<std::vector<size_t>> scenarioMatrix(double adjacencyDistance = 30.0) const;
+
+    DamageResult evaluate(const Ship& ship, const std::vector<size_t>& flooded, DamageMethod method) const;
+
+    // Every scenario of every ship, over the pool; results are ordered by ship, then by scenario
+    std::vector<DamageResult> run(const std::vector<const Ship*>& ships, const std::vector<std::vector<size_t>>& scenarios,
+        DamageMethod method, WorkStealingPool& pool) const;
+
+private:
+    static constexpr double seaWaterDensity = 1.025;
+    static constexpr double lengthBetweenPerpendiculars = 278.2;
+    static const int maxIterations = 100;
+    static constexpr double tolerance = 1e-4;
+
+    const ShipModel& model;
+    Permeabilities permeabilities;
+    std::vector<std::string> compartments;
+    std::vector<bool> holds;
+    std::vector<size_t> offsets;
+    std::vector<size_t> rowCounts;
+    std::vector<double> fullLcg, fullTcg;
+
+    // Rows of every compartment, concatenated; levels are heights above the baseline [m]
+    std::vector<double> levelColumn, volumeColumn, lcgColumn, tcgColumn, vcgColumn, inertiaColumn, areaColumn;
+
+    // Appends the rows of a compartment, with soundings converted to metres by soundingScale
+    // The Inertia column holds the transverse moment of inertia of the free surface
+    template <class Schema, class Inertia>
+    void addCompartment(const std::string& key, bool hold, TableView<Schema> rows, double soundingScale);
+
+    // Volume, LCG, TCG, VCG, and inertia and area of the free surface of compartment k, filled up to level
+    void interpolate(size_t k, double level, double& volume, double& lcg, double& tcg, double& vcg, double& inertia, double& area) const;
+};
+
+#endif // DAMAGESTABILITY_H
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "DraftSurvey.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+typedef HydrostaticSchema Schema;
+
+// Implementing the constructor
+DraftSurvey::DraftSurvey(const ShipModel& model, const DraftMarks& marks)
+    : marks(marks), bucketWidth(0.0) {
+    TableView<Schema> hydrostaticData = model.getHydrostaticTable();
+    for (size_t r = 0; r < hydrostaticData.size(); ++r) {
+        const double* row = hydrostaticData[r];
+        // Rows that break the ordering of draught or displacement are misread lines of the PDF file
+        if (!draughts.empty() && (row[Schema::Draught::index] <= draughts.back() || row[Schema::Displacement::index] <= displacements.back())) {
+            continue;
+        }
+        draughts.push_back(row[Schema::Draught::index]);
+        displacements.push_back(row[Schema::Displacement::index]);
+        LCFs.push_back(row[Schema::LCF::index]);
+        MCTs.push_back(row[Schema::MCT::index]);
+    }
+    if (draughts.size() < 2) {
+        throw std::runtime_error("Insufficient hydrostatic data for a draft survey.");
+    }
+
+    // Four buckets per row keep the forward scan from a bucket to its row short, even where rows are unevenly spaced
+    const size_t bucketCount = 4 * draughts.size();
+    bucketWidth = (draughts.back() - draughts.front()) / bucketCount;
+    buckets.resize(bucketCount + 1);
+    size_t i = 0;
+    for (size_t b = 0; b <= bucketCount; ++b) {
+        const double draught = draughts.front() + b * bucketWidth;
+        while (i + 2 < draughts.size() && draughts[i + 1] <= draught) {
+            ++i;
+        }
+        buckets[b] = i;
+    }
+}
+
+// Implementing the survey method
+SurveyResult DraftSurvey::survey(const DraftReadings& readings, const CompartmentProperties& compartments) const {
+    const double L = lengthBetweenPerpendiculars;
+    SurveyResult result;
+
+    // Mean of both sides at each set of marks
+    const double fore = 0.5 * (readings.foreP + readings.foreS);
+    const double mid = 0.5 * (readings.midP + readings.midS);
+    const double aft = 0.5 * (readings.aftP + readings.aftS);
+
+    // Corrections to the perpendiculars and to midship, along the line through the fore and aft marks
+    const double foreMark = L - marks.fore;
+    const double aftMark = marks.aft;
+    const double markDistance = foreMark - aftMark;
+    if (markDistance <= 0.0) {
+        throw std::runtime_error("Fore draught marks must lie forward of the aft draught marks.");
+    }
+    const double slope = (fore - aft) / markDistance;
+    result.TF = fore + slope * (L - foreMark);
+    result.TA = aft - slope * aftMark;
+    result.TM = mid + slope * marks.mid;
+    result.trim = result.TA - result.TF;
+
+    // Mean of means, allowing for hogging or sagging
+    result.quarterMean = (result.TF + result.TA + 6 * result.TM) / 8;
+
+    double LCF, TPC, MCT;
+    std::tie(result.tableDisplacement, LCF, TPC, MCT) = interpolate(result.quarterMean);
+
+    // First trim correction brings the quarter mean draught to the centre of flotation
+    result.firstTrimCorrection = -result.trim * LCF * TPC * 100 / L;
+
+    // Second trim correction (Nemoto), from the change of MCT over one metre of draught
+    // Near the ends of the table the probes are clamped, so the change is scaled from the draughts actually probed
+    double unused, MCTabove, MCTbelow;
+    const double above = std::min(result.quarterMean + 0.5, draughts.back());
+    const double below = std::max(result.quarterMean - 0.5, draughts.front());
+    std::tie(unused, unused, unused, MCTabove) = interpolate(above);
+    std::tie(unused, unused, unused, MCTbelow) = interpolate(below);
+    const double dMCTdT = (above > below) ? (MCTabove - MCTbelow) / (above - below) : 0.0;
+    result.secondTrimCorrection = 50 * result.trim * result.trim * dMCTdT / L;
+
+    result.displacement = (result.tableDisplacement + result.firstTrimCorrection + result.secondTrimCorrection) * readings.density / tableDensity;
+
+    // Ballast, consumables and the rest of the condition, apart from the cargo holds and the lightweight
+    result.deductibles = 0.0;
+    result.lightweight = 0.0;
+    result.conditionCargo = 0.0;
+    for (const auto& entry : compartments) {
+        const double mass = std::get<0>(entry.second);
+        if (entry.first == "Lightweight") {
+            result.lightweight += mass;
+        }
+        else if (entry.first.compare(0, 3, "R1.") == 0) {
+            result.conditionCargo += mass;
+        }
+        else {
+            result.deductibles += mass;
+        }
+    }
+    result.cargo = result.displacement - result.lightweight - result.deductibles;
+
+    return result;
+}
+
+// Implementing the interpolate method
+std::tuple<double, double, double, double> DraftSurvey::interpolate(double draught) const {
+    if (draught < draughts.front() || draught > draughts.back()) {
+        throw std::out_of_range("Draught outside of the hydrostatic table: " + std::to_string(draught));
+    }
+    const size_t i = findRow(draught);
+    const double span = draughts[i + 1] - draughts[i];
+    const double fraction = (draught - draughts[i]) / span;
+    const double displacement = displacements[i] + fraction * (displacements[i + 1] - displacements[i]);
+    const double LCF = LCFs[i] + fraction * (LCFs[i + 1] - LCFs[i]);
+    const double MCT = MCTs[i] + fraction * (MCTs[i + 1] - MCTs[i]);
+    // Tonnes per centimetre immersion, from the slope of the displacement over the interval
+    const double TPC = (displacements[i + 1] - displacements[i]) / span / 100;
+    return std::make_tuple(displacement, LCF, TPC, MCT);
+}
+
+// Implementing the writeHeader method
+void DraftSurvey::writeHeader(std::ostream& output) {
+    output << "label,tf,ta,tm,trim,quarter_mean,table_displacement,first_trim_correction,second_trim_correction,displacement,"
+        "deductibles,lightweight,cargo,condition_cargo,cargo_difference" << '\n';
+}
+
+// Implementing the writeRecord method
+void DraftSurvey::writeRecord(std::ostream& output, const std::string& label, const SurveyResult& result) {
+    char line[512];
+    snprintf(line, sizeof(line), ",%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f",
+        result.TF, result.TA, result.TM, result.trim, result.quarterMean, result.tableDisplacement, result.firstTrimCorrection,
+        result.secondTrimCorrection, result.displacement, result.deductibles, result.lightweight, result.cargo, result.conditionCargo,
+        result.cargo - result.conditionCargo);
+    output << label << line << '\n';
+}
+
+// Implementing the findRow method
+// Index i of the interval draughts[i] <= draught < draughts[i + 1], within the table
+size_t DraftSurvey::findRow(double draught) const {
+    size_t b = std::min(static_cast<size_t>((draught - draughts.front()) / bucketWidth), buckets.size() - 1);
+    size_t i = buckets[b];
+    while (i + 2 < draughts.size() && draughts[i + 1] <= draught) {
+        ++i;
+    }
+    return i;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef DRAFTSURVEY_H
+#define DRAFTSURVEY_H
+
+#include "ShipModel.h"
+#include "ResultWriter.h"
+#include <string>
+#include <vector>
+#include <tuple>
+#include <ostream>
+#include <stdexcept>
+
+// Draughts read at the marks on both sides [m], and the density of the water the ship floats in [t/m3]
+struct DraftReadings {
+    double foreP, foreS, midP, midS, aftP, aftS;
+    double density;
+};
+
+// Positions of the draught marks [m]: fore marks aft of the FP, midship marks aft of midship, aft marks forward of the AP
+struct DraftMarks {
+    double fore = 0.0;
+    double mid = 0.0;
+    double aft = 0.0;
+};
+
+// Steps of a draft survey, from the readings to the cargo on board
+struct SurveyResult {
+    // Draughts at the perpendiculars and at midship, trim (positive by the stern) and quarter mean draught [m]
+    double TF, TA, TM, trim, quarterMean;
+    // Displacement read from the table at the quarter mean draught, its first and second trim corrections,
+    // and the displacement corrected for trim and water density [tons]
+    double tableDisplacement, firstTrimCorrection, secondTrimCorrection, displacement;
+    // Ballast and consumables, lightweight, and the cargo found by the survey and in the loading condition [tons]
+    double deductibles, lightweight, cargo, conditionCargo;
+};
+
+// Draft survey: displacement from observed draughts, through the hydrostatic table read in reverse
+// The table is indexed once by draught, with buckets of equal width pointing to the first row of each,
+// so that a lookup takes a constant number of steps
+class DraftSurvey {
+public:
+    DraftSurvey(const ShipModel& model, const DraftMarks& marks = DraftMarks());
+
+    // Deductibles are every compartment of the condition other than the cargo holds and the lightweight
+    SurveyResult survey(const DraftReadings& readings, const CompartmentProperties& compartments) const;
+
+    // Displacement [tons], LCF from midship [m], TPC [t/cm] and MCT [t.m/cm] at the given draught, in the water of the table
+    std::tuple<double, double, double, double> interpolate(double draught) const;
+
+    // One CSV row per survey, after a header naming the steps
+    static void writeHeader(std::ostream& output);
+    static void writeRecord(std::ostream& output, const std::string& label, const SurveyResult& result);
+
+private:
+    static constexpr double tableDensity = 1.025;
+    static constexpr double lengthBetweenPerpendiculars = 278.2;
+
+    DraftMarks marks;
+
+    // Rows of the hydrostatic table in increasing draught
+    std::vector<double> draughts, displacements, LCFs, MCTs;
+
+    // Inverse index: first row of every bucket of draughts
+    std::vector<size_t> buckets;
+    double bucketWidth;
+
+    size_t findRow(double draught) const;
+};
+
+#endif // DRAFTSURVEY_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "GaugeStream.h"
+#include <iostream>
+#include <cstdlib>
+#include <cctype>
+
+// Implementing the constructor
+GaugeStream::GaugeStream(Ship& ship, ResultWriter& writer)
+    : ship(ship), writer(writer), histogram(bucketCount, 0), updates(0), rejected(0), totalLatency(0.0), maxLatency(0.0), elapsed(0.0) {
+}
+
+// Implementing the run method
+void GaugeStream::run(std::istream& input) {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+
+    // Buffers are reused from one record to the next
+    std::string line, timestamp, key;
+    double sounding;
+    while (std::getline(input, line)) {
+        const Clock::time_point received = Clock::now();
+        if (line.empty() || line[0] == '#' || line[0] == '\r') {
+            continue;
+        }
+        if (!parseRecord(line, timestamp, key, sounding)) {
+            ++rejected;
+            std::cerr << "Malformed gauge record: " << line << std::endl;
+            continue;
+        }
+        try {
+            ship.updateSounding(key, sounding);
+        }
+        catch (const std::exception& e) {
+            ++rejected;
+            std::cerr << e.what() << std::endl;
+            continue;
+        }
+        ship.writeResults(writer, timestamp);
+        record(std::chrono::duration<double, std::micro>(Clock::now() - received).count());
+
+        if (input.rdbuf()->in_avail() <= 0) {
+            writer.flush();
+        }
+    }
+    writer.flush();
+
+    elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Implementing the getStatistics method
+LatencyStatistics GaugeStream::getStatistics() const {
+    LatencyStatistics statistics;
+    statistics.updates = updates;
+    statistics.rejected = rejected;
+    statistics.mean = (updates > 0) ? totalLatency / updates : 0.0;
+    statistics.p50 = percentile(0.50);
+    statistics.p99 = percentile(0.99);
+    statistics.max = maxLatency;
+    statistics.elapsed = elapsed;
+    return statistics;
+}
+
+// Implementing the record method
+void GaugeStream::record(double latency) {
+    ++updates;
+    totalLatency += latency;
+    if (latency > maxLatency) {
+        maxLatency = latency;
+    }
+    size_t bucket = static_cast<size_t>(latency / bucketWidth);
+    if (bucket < bucketCount) {
+        ++histogram[bucket];
+    }
+}
+
+// Implementing the percentile method
+// Upper edge of the bucket holding the requested fraction of updates, or the maximum if it lies beyond the histogram
+double GaugeStream::percentile(double fraction) const {
+    if (updates == 0) {
+        return 0.0;
+    }
+    size_t target = static_cast<size_t>(fraction * updates);
+    size_t count = 0;
+    for (size_t i = 0; i < bucketCount; ++i) {
+        count += histogram[i];
+        if (count > target) {
+            return (i + 1) * bucketWidth;
+        }
+    }
+    return maxLatency;
+}
+
+// Implementing the parseRecord method
+bool GaugeStream::parseRecord(const std::string& line, std::string& timestamp, std::string& key, double& sounding) {
+    const char* position = line.c_str();
+    std::string* fields[2] = { &timestamp, &key };
+    for (std::string* field : fields) {
+        while (std::isspace(static_cast<unsigned char>(*position))) {
+            ++position;
+        }
+        const char* begin = position;
+        while (*position != '\0' && !std::isspace(static_cast<unsigned char>(*position))) {
+            ++position;
+        }
+        if (position == begin) {
+            return false;
+        }
+        field->assign(begin, position);
+    }
+    char* end;
+    sounding = std::strtod(position, &end);
+    if (end == position) {
+        return false;
+    }
+    while (std::isspace(static_cast<unsigned char>(*end))) {
+        ++end;
+    }
+    return *end == '\0';
+}
\ No newline at end of file
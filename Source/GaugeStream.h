@@ -0,0 +1,51 @@
+#ifndef GAUGESTREAM_H
+#define GAUGESTREAM_H
+
+#include "Ship.h"
+#include "ResultWriter.h"
+#include <string>
+#include <vector>
+#include <istream>
+#include <chrono>
+
+// Summary of the update latencies, from reading a record to publishing the new equilibrium
+struct LatencyStatistics {
+    size_t updates, rejected;
+    // Latencies in microseconds; percentiles are resolved to the histogram bucket width
+    double mean, p50, p99, max;
+    // Wall clock time of the stream, in seconds
+    double elapsed;
+};
+
+// Live gauge mode, standing in for the automation system of the ship
+// Each record is "<timestamp> <compartment> <sounding in cm>", one per line, from a pipe or a file
+// Only the gauged tank is recomputed, and the equilibrium follows from the running moment totals of the ship
+// Blank lines and lines starting with '#' are ignored; malformed records are rejected without ending the stream
+class GaugeStream {
+public:
+    GaugeStream(Ship& ship, ResultWriter& writer);
+
+    // Applies records until the end of the input, publishing one result record per update
+    // The writer is flushed whenever the input has no more data waiting, i.e. at the end of each burst
+    void run(std::istream& input);
+
+    LatencyStatistics getStatistics() const;
+
+private:
+    Ship& ship;
+    ResultWriter& writer;
+
+    // Latency histogram in 0.1 microsecond buckets up to 1 ms; slower updates only count towards the maximum
+    static const size_t bucketCount = 10000;
+    static constexpr double bucketWidth = 0.1;
+    std::vector<size_t> histogram;
+    size_t updates, rejected;
+    double totalLatency, maxLatency, elapsed;
+
+    void record(double latency);
+    double percentile(double fraction) const;
+
+    static bool parseRecord(const std::string& line, std::string& timestamp, std::string& key, double& sounding);
+};
+
+#endif // GAUGESTREAM_H
\ No newline at end of file
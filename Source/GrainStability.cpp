@@ -0,0 +1,130 @@
+#include "GrainStability.h"
+#include <algorithm>
+#include <cmath>
+
+typedef CargoHoldSchema Schema;
+
+static const double radiansPerDegree = std::acos(-1.0) / 180;
+
+// Implementing the constructor
+// Shorter tables are padded with empty intervals, which add nothing to the sum
+GrainStability::GrainStability(const ShipModel& model)
+    : rowCount(0) {
+    for (size_t h = 0; h < holdCount; ++h) {
+        TableView<Schema> cargoData = model.getCargoHold(static_cast<int>(h) + 1);
+        if (cargoData.size() < 2) {
+            throw std::runtime_error("Insufficient cargo hold data for hold " + std::to_string(h + 1));
+        }
+        rowCount = std::max(rowCount, cargoData.size());
+    }
+
+    const size_t intervalCount = rowCount - 1;
+    lowerVolumes.assign(intervalCount * holdCount, 0.0);
+    inverseSpans.assign(intervalCount * holdCount, 0.0);
+    momentSteps.assign(intervalCount * holdCount, 0.0);
+    for (size_t h = 0; h < holdCount; ++h) {
+        TableView<Schema> cargoData = model.getCargoHold(static_cast<int>(h) + 1);
+        baseMoments[h] = std::max(cargoData[0][Schema::FSM::index], 0.0);
+        capacities[h] = cargoData.back()[Schema::Volume::index];
+        for (size_t r = 0; r + 1 < cargoData.size(); ++r) {
+            const double* lower = cargoData[r];
+            const double* upper = cargoData[r + 1];
+            const double span = upper[Schema::Volume::index] - lower[Schema::Volume::index];
+            lowerVolumes[r * holdCount + h] = lower[Schema::Volume::index];
+            if (span > 0.0) {
+                inverseSpans[r * holdCount + h] = 1.0 / span;
+                momentSteps[r * holdCount + h] = std::max(upper[Schema::FSM::index], 0.0) - std::max(lower[Schema::FSM::index], 0.0);
+            }
+        }
+        for (size_t r = cargoData.size() - 1; r < intervalCount; ++r) {
+            lowerVolumes[r * holdCount + h] = capacities[h];
+        }
+    }
+}
+
+// Implementing the interpolateMoments method
+void GrainStability::interpolateMoments(const double volumes[holdCount], double moments[holdCount]) const {
+    for (size_t h = 0; h < holdCount; ++h) {
+        moments[h] = baseMoments[h];
+    }
+    const double* lower = lowerVolumes.data();
+    const double* inverseSpan = inverseSpans.data();
+    const double* step = momentSteps.data();
+    for (size_t r = 0; r + 1 < rowCount; ++r) {
+        for (size_t h = 0; h < holdCount; ++h) {
+            const size_t i = r * holdCount + h;
+            const double fraction = std::min(std::max((volumes[h] - lower[i]) * inverseSpan[i], 0.0), 1.0);
+            moments[h] += fraction * step[i];
+        }
+    }
+}
+
+// Implementing the check method
+GrainResults GrainStability::check(const double volumes[holdCount], double stowageFactor, double displacement, double GM) const {
+    if (stowageFactor <= 0.0 || displacement <= 0.0) {
+        throw std::invalid_argument("Stowage factor and displacement must be positive.");
+    }
+    GrainResults results;
+
+    // The FSM column is the transverse moment of inertia i of the grain surface; shifted by 25 degrees, the surface moves
+    // a volume of about i tan 25 degrees across the hold
+    // Empty holds carry no grain, whatever the FSM the tables give at zero volume, and filled holds are left out (see check)
+    interpolateMoments(volumes, results.volumetricMoments);
+    const double shiftFactor = std::tan(partlyFilledShiftAngle * radiansPerDegree) * partlyFilledFactor;
+    double volumetricMoment = 0.0;
+    for (size_t h = 0; h < holdCount; ++h) {
+        const bool partlyFilled = volumes[h] > 0.0 && volumes[h] < capacities[h] * (1.0 - 1e-9);
+        results.volumetricMoments[h] = partlyFilled ? results.volumetricMoments[h] * shiftFactor : 0.0;
+        volumetricMoment += results.volumetricMoments[h];
+    }
+
+    results.heelingMoment = volumetricMoment / stowageFactor;
+    results.heelingArm0 = results.heelingMoment / displacement;
+    results.heelingArm40 = 0.8 * results.heelingArm0;
+    results.GM = GM;
+
+    // Righting arms are taken as GM sin(heel), as no cross curves are available
+    // The heeling arm falls linearly from heelingArm0 upright to heelingArm40 at 40 degrees
+    const double limit = 40.0 * radiansPerDegree;
+    auto difference = [&](double angle) {
+        return GM * std::sin(angle) - (results.heelingArm0 + (results.heelingArm40 - results.heelingArm0) * angle / limit);
+    };
+
+    if (difference(limit) < 0.0) {
+        results.heelAngle = 40.0;
+        results.residualArea = 0.0;
+    }
+    else {
+        double low = 0.0, high = limit;
+        if (difference(0.0) >= 0.0) {
+            high = 0.0;
+        }
+        for (int k = 0; k < 60 && high - low > 1e-9; ++k) {
+            const double middle = 0.5 * (low + high);
+            (difference(middle) < 0.0 ? low : high) = middle;
+        }
+        results.heelAngle = high / radiansPerDegree;
+
+        // Simpson's rule between the angle of heel and 40 degrees
+        const int intervals = 20;
+        const double width = (limit - high) / intervals;
+        double area = difference(high) + difference(limit);
+        for (int k = 1; k < intervals; ++k) {
+            area += (k % 2 == 1 ? 4 : 2) * difference(high + k * width);
+        }
+        results.residualArea = area * width / 3;
+    }
+
+    results.heelAngleMet = results.heelAngle <= maxHeelAngle;
+    results.GMMet = results.GM >= minGM;
+    results.residualAreaMet = results.residualArea >= minResidualArea;
+    return results;
+}
+
+// Implementing the getCapacity method
+double GrainStability::getCapacity(size_t hold) const {
+    if (hold >= holdCount) {
+        throw std::out_of_range("Non-existent cargo hold index.");
+    }
+    return capacities[hold];
+}
\ No newline at end of file
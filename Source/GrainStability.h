@@ -0,0 +1,59 @@
+#ifndef GRAINSTABILITY_H
+#define GRAINSTABILITY_H
+
+#include "ShipModel.h"
+#include <vector>
+#include <stdexcept>
+
+// Grain heeling moments of the cargo holds and the intact stability criteria of the International Grain Code
+struct GrainResults {
+    // Volumetric heeling moment of each hold: the transverse shift of the grain surface, by i tan 25 degrees,
+    // times the factor for its vertical shift [m4]
+    double volumetricMoments[ShipModel::holdCount];
+    // Grain heeling moment [t.m], and heeling arms at 0 and 40 degrees [m]
+    double heelingMoment, heelingArm0, heelingArm40;
+    // Angle of heel due to the grain shift [deg] and residual area between the righting and heeling arm curves up to 40 degrees [m.rad]
+    double heelAngle, residualArea;
+    // Metacentric height after the free surface correction of the tanks [m]
+    double GM;
+    bool heelAngleMet, GMMet, residualAreaMet;
+};
+
+// Free surface moments of the cargo holds, from the FSM column of the hold files, for all holds at once
+// The hold tables are stored row by row with the holds side by side, and interpolated as a sum of clamped segments,
+// so that every step is the same for all nine holds and the loops vectorize
+class GrainStability {
+public:
+    static const size_t holdCount = ShipModel::holdCount;
+
+    // Grain Code criteria
+    static constexpr double maxHeelAngle = 12.0;
+    static constexpr double minGM = 0.30;
+    static constexpr double minResidualArea = 0.075;
+
+    GrainStability(const ShipModel& model);
+
+    // FSM column of every hold at the given cargo volumes [m3]; volumes beyond the tables are clamped
+    void interpolateMoments(const double volumes[holdCount], double moments[holdCount]) const;
+
+    // Volumes are those of the cargo in each hold; GM is corrected for the free surfaces of the tanks
+    // Filled holds contribute no moment: the 15 degree shift of the void under the deck depends on the depth of the void,
+    // the hatch coamings and the girders, which the hold files do not give, so filled holds must be assessed separately
+    GrainResults check(const double volumes[holdCount], double stowageFactor, double displacement, double GM) const;
+
+    double getCapacity(size_t hold) const;
+
+private:
+    // Angle of the shifted grain surface, and factor for its vertical shift, for partly filled holds
+    static constexpr double partlyFilledShiftAngle = 25.0;
+    static constexpr double partlyFilledFactor = 1.12;
+
+    size_t rowCount;
+    // Lower volume of each interval, the inverse of its width and the change of FSM over it, as [interval][hold]
+    std::vector<double> lowerVolumes, inverseSpans, momentSteps;
+    // FSM of the empty holds and capacities of the holds
+    double baseMoments[holdCount];
+    double capacities[holdCount];
+};
+
+#endif // GRAINSTABILITY_H
\ No newline at end of file
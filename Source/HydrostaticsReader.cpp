@@ -1,17 +1,16 @@
 #include "HydrostaticsReader.h"
 
 // Implementing the constructor
-HydrostaticsReader::HydrostaticsReader(const std::string& fileName, double displacement)
-    : currentColumn(0), currentRow(0), displacement(displacement) {
-    FPDF_InitLibrary();
+HydrostaticsReader::HydrostaticsReader(const std::string& fileName)
+    : currentColumn(0), currentRow(0) {
+    PdfLibrary library;
     FPDF_DOCUMENT document = FPDF_LoadDocument(fileName.c_str(), nullptr);
     if (!document) {
-        FPDF_DestroyLibrary();
         throw std::runtime_error("Unable to open PDF file " + fileName);
     }
 
     // Initial size of output matrix, based on the form of the PDF file 
-    hydrostaticData.resize(83, std::vector<double>(30));
+    hydrostaticData.resize(83, HydrostaticSchema::Row());
 
     int pageCount = FPDF_GetPageCount(document);
 
@@ -28,60 +27,41 @@ HydrostaticsReader::HydrostaticsReader(const std::string& fileName, double displ
     }
 
     FPDF_CloseDocument(document);
-    FPDF_DestroyLibrary();
 }
 
 // Implementing the getData method
-const std::vector<std::vector<double>>& HydrostaticsReader::getData() const {
+const std::vector<HydrostaticSchema::Row>& HydrostaticsReader::getData() const {
     return hydrostaticData;
 }
 
-// Implementing the interpolate method
-std::tuple<double, double, double, double, double, double> HydrostaticsReader::interpolate() const {
-    if (hydrostaticData.empty() || hydrostaticData[1].empty()) {
-        throw std::runtime_error("Matrix is empty or not properly initialized.");
-    }
-
-    size_t idx1 = 0, idx2 = 1;
-    double diff1 = std::abs(hydrostaticData[idx1][1] - displacement);
-    double diff2 = std::abs(hydrostaticData[idx2][1] - displacement);
-
-    // Find the rows for which interpolation is to be performed
-    for (size_t i = 2; i < hydrostaticData.size(); ++i) {
-        double currentDiff = std::abs(hydrostaticData[i][1] - displacement);
-        if (currentDiff < diff1) {
-            idx2 = idx1;
-            diff2 = diff1;
-            idx1 = i;
-            diff1 = currentDiff;
+namespace {
+    // Interpolation shared by the double tables and their single precision copy
+    template <class Value>
+    std::tuple<double, double, double, double, double, double> interpolateHydrostatics(TableView<HydrostaticSchema, Value> hydrostaticData, double displacement) {
+        if (hydrostaticData.size() < 2) {
+            throw std::runtime_error("Matrix is empty or not properly initialized.");
         }
-        else if (currentDiff < diff2) {
-            idx2 = i;
-            diff2 = currentDiff;
-        }
-    }
 
-    // 139.1 is half the ship's LBP
-    double draughtMoulded, LCF, LCB, VCB, KMT, MCT;
-    if (hydrostaticData[idx1][1] != hydrostaticData[idx2][1]) {
-        double fraction = (displacement - hydrostaticData[idx1][1]) / (hydrostaticData[idx2][1] - hydrostaticData[idx1][1]);
-        draughtMoulded = hydrostaticData[idx1][0] + fraction * (hydrostaticData[idx2][0] - hydrostaticData[idx1][0]);
-        LCF = 139.1 + hydrostaticData[idx1][4] + fraction * (hydrostaticData[idx2][4] - hydrostaticData[idx1][4]);
-        LCB = 139.1 + hydrostaticData[idx1][5] + fraction * (hydrostaticData[idx2][5] - hydrostaticData[idx1][5]);
-        VCB = hydrostaticData[idx1][6] + fraction * (hydrostaticData[idx2][6] - hydrostaticData[idx1][6]);
-        KMT = hydrostaticData[idx1][7] + fraction * (hydrostaticData[idx2][7] - hydrostaticData[idx1][7]);
-        MCT = hydrostaticData[idx1][11] + fraction * (hydrostaticData[idx2][11] - hydrostaticData[idx1][11]);
-    }
-    else {
-        draughtMoulded = hydrostaticData[idx1][0];
-        LCB = 139.1 + hydrostaticData[idx1][4];
-        LCB = 139.1 + hydrostaticData[idx1][5];
-        VCB = hydrostaticData[idx1][6];
-        KMT = hydrostaticData[idx1][7];
-        MCT = hydrostaticData[idx1][11];
+        double draughtMoulded, LCF, LCB, VCB, KMT, MCT;
+        std::tie(draughtMoulded, LCF, LCB, VCB, KMT, MCT) = interpolateNearest<HydrostaticSchema, HydrostaticSchema::Displacement,
+            HydrostaticSchema::Draught, HydrostaticSchema::LCF, HydrostaticSchema::LCB, HydrostaticSchema::VCB, HydrostaticSchema::KMT, HydrostaticSchema::MCT>(hydrostaticData, displacement);
+
+        // 139.1 is half the ship's LBP
+        LCF += 139.1;
+        LCB += 139.1;
+
+        return std::make_tuple(draughtMoulded, LCF, LCB, VCB, KMT, MCT);
     }
+}
+
+// Implementing the interpolate method
+std::tuple<double, double, double, double, double, double> HydrostaticsReader::interpolate(TableView<HydrostaticSchema> hydrostaticData, double displacement) {
+    return interpolateHydrostatics(hydrostaticData, displacement);
+}
 
-    return std::make_tuple(draughtMoulded, LCF, LCB, VCB, KMT, MCT);
+// Implementing the interpolate method for single precision tables
+std::tuple<double, double, double, double, double, double> HydrostaticsReader::interpolate(TableView<HydrostaticSchema, float> hydrostaticData, double displacement) {
+    return interpolateHydrostatics(hydrostaticData, displacement);
 }
 
 // Implementing the extractNumericalValues method
@@ -156,12 +136,12 @@ void HydrostaticsReader::insertValues(const std::vector<double>& values) {
 
     // In the case that the initial size estimation is incorrect
     if (currentRow + numValues > hydrostaticData.size()) {
-        hydrostaticData.resize(currentRow + numValues, std::vector<double>(30));
+        hydrostaticData.resize(currentRow + numValues, HydrostaticSchema::Row());
     }
 
     // Popoulating the matrix
     for (size_t i = 0; i < numValues; ++i) {
-        if (currentRow + i < hydrostaticData.size() && currentColumn < hydrostaticData[currentRow + i].size()) {
+        if (currentRow + i < hydrostaticData.size() && currentColumn < HydrostaticSchema::columnCount) {
             hydrostaticData[currentRow + i][currentColumn] = values[i];
         }
         else {
@@ -171,7 +151,7 @@ void HydrostaticsReader::insertValues(const std::vector<double>& values) {
 
     currentColumn++;
 
-    if (currentColumn >= 30) {
+    if (currentColumn >= HydrostaticSchema::columnCount) {
         currentColumn = 0;
         currentRow += numValues;
     }
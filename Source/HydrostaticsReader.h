@@ -7,20 +7,25 @@
 #include <regex>
 #include <fpdfview.h>
 #include <fpdf_text.h>
+#include "PdfLibrary.h"
 #include <stdexcept>
 #include <tuple>
+#include "TableSchemas.h"
 
 class HydrostaticsReader {
 public:
-    HydrostaticsReader(const std::string& fileName, double displacement);
-    const std::vector<std::vector<double>>& getData() const;
-    std::tuple<double, double, double, double, double, double> interpolate() const;
+    HydrostaticsReader(const std::string& fileName);
+    const std::vector<HydrostaticSchema::Row>& getData() const;
+    
+    // Draught moulded, LCF, LCB, VCB, KMT and MCT for the given displacement
+    static std::tuple<double, double, double, double, double, double> interpolate(TableView<HydrostaticSchema> hydrostaticData, double displacement);
+
+    static std::tuple<double, double, double, double, double, double> interpolate(TableView<HydrostaticSchema, float> hydrostaticData, double displacement);
 
 private:
-    std::vector<std::vector<double>> hydrostaticData;
+    std::vector<HydrostaticSchema::Row> hydrostaticData;
     size_t currentColumn;
     size_t currentRow;
-    double displacement;
 
     std::vector<double> extractNumericalValues(const std::string& line);
     void searchForPattern(FPDF_PAGE page);
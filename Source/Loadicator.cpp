@@ -1,13 +1,436 @@
 ﻿#include "Ship.h"
+#include "GaugeStream.h"
+#include "RegressionHarness.h"
+#include "DamageStability.h"
+#include "DraftSurvey.h"
+#include "ShipModelSegment.h"
+#include "BallastExchangePlanner.h"
+#include "ConditionFileReader.h"
+#include "ResultCache.h"
+#include "VoyageSimulation.h"
+#include "ShipTableGenerator.h"
+#include "ConditionLog.h"
+#include "SoundingTrimTable.h"
+#include <unordered_map>
+#include <chrono>
 #include <iostream>
+#include <sstream>
+#include <fstream>
+#include <memory>
+#include <future>
 
-int main() {
+// Loads the ship model in the background, or attaches to the one published in shared memory under segmentName
+static std::shared_future<std::shared_ptr<const ShipModel>> loadModel(const std::string& soundingTables, const std::string& hydrostaticTables,
+    const std::string& segmentName) {
+    if (segmentName.empty()) {
+        return ShipModel::loadAsync(soundingTables, hydrostaticTables).share();
+    }
+    std::promise<std::shared_ptr<const ShipModel>> attached;
+    uint64_t generation;
+    attached.set_value(ShipModelSegment::attach(segmentName, generation));
+    return attached.get_future().share();
+}
+
+// Prints the grain heeling arms and the Grain Code criteria of a condition
+static void printGrainCheck(const std::string& condition, const GrainResults& grain) {
+    std::cout << "Loading Condition " << condition << ", grain heeling moment: " << grain.heelingMoment << " [tons*m]" << '\n';
+    std::cout << "Heeling arm at 0/40 deg: " << grain.heelingArm0 << " / " << grain.heelingArm40 << " [m]" << '\n';
+    std::cout << "Angle of heel: " << grain.heelAngle << " [deg] " << (grain.heelAngleMet ? "(met)" : "(NOT MET)") << '\n';
+    std::cout << "Corrected GM: " << grain.GM << " [m] " << (grain.GMMet ? "(met)" : "(NOT MET)") << '\n';
+    std::cout << "Residual area: " << grain.residualArea << " [m*rad] " << (grain.residualAreaMet ? "(met)" : "(NOT MET)") << std::endl;
+}
+
+// Times SoundingTrimTable::interpolate over every tank with a sounding table, for the whole set and for one tank at a time
+// The soundings and trims are spread over the range of the tables and computed beforehand, so that only the kernel is timed
+static void benchmarkGauge(const ShipModel& model) {
+    // Tanks whose tables keep fewer than two well-ordered rows cannot be interpolated, and are left out
+    std::vector<std::string> keys;
+    for (const std::string& key : model.getSoundingKeys()) {
+        try {
+            SoundingTrimTable single(model, std::vector<std::string>(1, key));
+            keys.push_back(key);
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    SoundingTrimTable table(model, keys);
+    const size_t tankCount = keys.size();
+    const size_t setCount = 64;
+    const size_t iterations = 100000;
+    std::vector<std::vector<double>> soundings(setCount, std::vector<double>(tankCount));
+    std::vector<double> trims(setCount);
+    for (size_t s = 0; s < setCount; ++s) {
+        trims[s] = -2.5 + 3.0 * s / (setCount - 1);
+        for (size_t t = 0; t < tankCount; ++t) {
+            TableView<SoundingTableSchema> rows = model.getSoundingTable(keys[t]);
+            const double top = rows[rows.size() - 1][SoundingTableSchema::Sounding::index];
+            soundings[s][t] = top * ((s * 37 + t * 11) % 100) / 100.0;
+        }
+    }
+
+    // The checksum keeps the results alive
+    SoundingResults results;
+    double checksum = 0.0;
+    table.interpolate(soundings[0], trims[0], results);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        table.interpolate(soundings[i % setCount], trims[i % setCount], results);
+        checksum += results.volume[i % tankCount];
+    }
+    const double batchTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    const size_t singleIterations = iterations / 10;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < singleIterations; ++i) {
+        for (size_t t = 0; t < tankCount; ++t) {
+            checksum += std::get<0>(table.interpolate(t, soundings[i % setCount][t], trims[i % setCount]));
+        }
+    }
+    const double singleTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (singleIterations * tankCount);
+
+    std::cout << "Tanks: " << tankCount << " (" << model.getSoundingKeys().size() - tankCount << " without usable tables), calls: " << iterations << '\n';
+    std::cout << "All tanks: " << batchTime / 1000.0 << " [us] per call, " << batchTime / tankCount << " [ns] per tank" << '\n';
+    std::cout << "One tank at a time: " << singleTime << " [ns] per tank" << '\n';
+    std::cout << "Checksum: " << checksum << std::endl;
+}
+
+int main(int argc, char* argv[]) {
     // Paths to data files
     std::string trimStabilityBook = "Data/Trim and stability book.pdf";
     std::string soundingTables = "Data/Sounding tables (1).txt";
     std::string hydrostaticTables = "Data/Hydrostatic tables.pdf";
     std::string userInput;
 
+    // Optional structured output: --format csv|jsonl|bin [--output file] [--compartments]
+    // Without --format, the human-readable Results.txt of a single condition is produced
+    std::string format;
+    std::string outputFile;
+    bool includeCompartments = false;
+    // Live gauge mode: --stream file|- applies timestamped gauge records to the entered condition
+    std::string gaugeRecords;
+    // Regression mode: --regression runs every condition of the book and compares the results with its Floating Condition blocks
+    bool regression = false;
+    // Gauge benchmark: --bench-gauge times the interpolation of the sounding tables on sounding and trim
+    bool benchGauge = false;
+    // Damage stability: --damage lost-buoyancy|added-weight floods every compartment and adjacent pair of the entered conditions
+    std::string damageMethod;
+    // Draft survey: --survey file|- reads "<label> <condition> <fore P> <fore S> <mid P> <mid S> <aft P> <aft S> <density>" records
+    std::string surveyRecords;
+    // Grain cargo: --grain lets the hold free surface moments heel the ship and checks the Grain Code criteria
+    bool grainCargo = false;
+    // Ballast water exchange: --exchange plans the sequential exchange of the ballast tanks of the entered conditions
+    bool exchange = false;
+    // Voyage: --voyage route steps the entered departure conditions along the route, writing draughts and under-keel clearance
+    std::string routeFile;
+    // Condition file: --conditions file evaluates the conditions it defines, without reading the trim and stability book
+    std::string conditionFile;
+    // Single precision: --single interpolates the tables in float; --regression reports the deviation of this mode from the double path
+    bool singlePrecision = false;
+    // Result cache: --cache file memoizes the equilibria of the condition file across runs
+    std::string cacheFile;
+    // Condition log: --log file appends the conditions of the condition file and their results; --replay file re-evaluates a log
+    std::string logFile;
+    std::string replayLog;
+    // Shared memory: --publish name loads the model into a segment and exits; --attach name uses the published model
+    std::string publishSegment;
+    std::string attachSegment;
+    // Embedded tables: --generate-tables file writes the ship model as the EmbeddedShipTables.h header and exits
+    std::string tablesHeader;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        }
+        else if (argument == "--output" && i + 1 < argc) {
+            outputFile = argv[++i];
+        }
+        else if (argument == "--stream" && i + 1 < argc) {
+            gaugeRecords = argv[++i];
+        }
+        else if (argument == "--damage" && i + 1 < argc) {
+            damageMethod = argv[++i];
+        }
+        else if (argument == "--survey" && i + 1 < argc) {
+            surveyRecords = argv[++i];
+        }
+        else if (argument == "--conditions" && i + 1 < argc) {
+            conditionFile = argv[++i];
+        }
+        else if (argument == "--voyage" && i + 1 < argc) {
+            routeFile = argv[++i];
+        }
+        else if (argument == "--log" && i + 1 < argc) {
+            logFile = argv[++i];
+        }
+        else if (argument == "--replay" && i + 1 < argc) {
+            replayLog = argv[++i];
+        }
+        else if (argument == "--cache" && i + 1 < argc) {
+            cacheFile = argv[++i];
+        }
+        else if (argument == "--generate-tables" && i + 1 < argc) {
+            tablesHeader = argv[++i];
+        }
+        else if (argument == "--publish" && i + 1 < argc) {
+            publishSegment = argv[++i];
+        }
+        else if (argument == "--attach" && i + 1 < argc) {
+            attachSegment = argv[++i];
+        }
+        else if (argument == "--exchange") {
+            exchange = true;
+        }
+        else if (argument == "--single") {
+            singlePrecision = true;
+        }
+        else if (argument == "--grain") {
+            grainCargo = true;
+        }
+        else if (argument == "--bench-gauge") {
+            benchGauge = true;
+        }
+        else if (argument == "--regression") {
+            regression = true;
+        }
+        else if (argument == "--compartments") {
+            includeCompartments = true;
+        }
+        else {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            return 1;
+        }
+    }
+
+    // Cached results hold no compartments, and grain cargo is checked on the ship itself
+    if (!cacheFile.empty() && (conditionFile.empty() || grainCargo || includeCompartments)) {
+        std::cerr << "--cache requires --conditions and cannot be combined with --grain or --compartments" << std::endl;
+        return 1;
+    }
+    // Grain cargo changes the heeling moment, which the log does not record
+    if (!logFile.empty() && (conditionFile.empty() || grainCargo)) {
+        std::cerr << "--log requires --conditions and cannot be combined with --grain" << std::endl;
+        return 1;
+    }
+
+    if (!tablesHeader.empty()) {
+        try {
+            ShipModel model(soundingTables, hydrostaticTables);
+            ShipTableGenerator::generate(model, tablesHeader);
+            std::cout << "Ship tables have been written to " << tablesHeader << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!publishSegment.empty()) {
+        try {
+            std::shared_ptr<const ShipModel> model = ShipModel::loadAsync(soundingTables, hydrostaticTables).get();
+            uint64_t generation = ShipModelSegment::publish(*model, publishSegment);
+            std::cout << "Ship model published as " << publishSegment << ", generation " << generation << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (benchGauge) {
+        try {
+            benchmarkGauge(*loadModel(soundingTables, hydrostaticTables, attachSegment).get());
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!replayLog.empty()) {
+        try {
+            WorkStealingPool pool;
+            ReplayReport report = ConditionLog::replay(loadModel(soundingTables, hydrostaticTables, attachSegment).get(), replayLog, pool);
+            std::cout << "Records: " << report.read.records << " (" << report.read.corrupt << " corrupt frames, " << report.read.skipped
+                << " records skipped) decoded in " << report.decodeTime << " [s]" << '\n';
+            std::cout << "Replayed in " << report.evaluateTime << " [s] on " << report.threadCount << " threads: " << report.recordsPerSecond
+                << " records/s" << '\n';
+            std::cout << "Mismatches: " << report.mismatches.size() << ", largest deviation: " << report.maxDeviation << '\n';
+            for (const ReplayMismatch& mismatch : report.mismatches) {
+                std::cout << "  Record " << mismatch.record << " (" << mismatch.label << "): deviation " << mismatch.deviation << '\n';
+            }
+            std::cout.flush();
+            return (report.mismatches.empty() && report.read.corrupt == 0) ? 0 : 1;
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (regression) {
+        try {
+            RegressionHarness harness(trimStabilityBook, soundingTables, hydrostaticTables);
+            harness.run();
+            if (outputFile.empty()) {
+                outputFile = "Regression.csv";
+            }
+            harness.writeReport(outputFile);
+            harness.printSummary(std::cout);
+            std::cout << "Report has been written to " << outputFile << std::endl;
+            return harness.getFailureCount() == 0 ? 0 : 1;
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Lets std::cin buffer a burst of gauge records, so that the stream can tell when it has been drained
+    if (gaugeRecords == "-") {
+        std::ios::sync_with_stdio(false);
+    }
+
+    if (!surveyRecords.empty()) {
+        try {
+            std::ifstream surveyFile;
+            if (surveyRecords != "-") {
+                surveyFile.open(surveyRecords);
+                if (!surveyFile.is_open()) {
+                    throw std::runtime_error("Failed to open " + surveyRecords + " for reading.");
+                }
+            }
+            std::istream& surveys = (surveyRecords == "-") ? std::cin : surveyFile;
+            if (outputFile.empty()) {
+                outputFile = "Survey.csv";
+            }
+            std::ofstream report(outputFile);
+            if (!report.is_open()) {
+                throw std::runtime_error("Failed to open " + outputFile + " for writing.");
+            }
+            DraftSurvey::writeHeader(report);
+
+            // Each loading condition supplies the deductibles of its surveys, and is read from the book only once
+            std::shared_future<std::shared_ptr<const ShipModel>> model = loadModel(soundingTables, hydrostaticTables, attachSegment);
+            std::unique_ptr<DraftSurvey> draftSurvey;
+            std::unordered_map<std::string, std::unique_ptr<Ship>> ships;
+            size_t surveyCount = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            std::string line;
+            while (std::getline(surveys, line)) {
+                std::istringstream record(line);
+                std::string label, condition;
+                DraftReadings readings;
+                if (!(record >> label >> condition >> readings.foreP >> readings.foreS >> readings.midP >> readings.midS
+                    >> readings.aftP >> readings.aftS >> readings.density)) {
+                    if (!label.empty() && label[0] != '#') {
+                        std::cerr << "Malformed survey record: " << line << std::endl;
+                    }
+                    continue;
+                }
+                try {
+                    std::unique_ptr<Ship>& ship = ships[condition];
+                    if (!ship) {
+                        ship.reset(new Ship(model, trimStabilityBook, condition));
+                    }
+                    if (!draftSurvey) {
+                        draftSurvey.reset(new DraftSurvey(*model.get()));
+                    }
+                    DraftSurvey::writeRecord(report, label, draftSurvey->survey(readings, ship->getCompartments()));
+                    ++surveyCount;
+                }
+                catch (const std::exception& e) {
+                    ships.erase(condition);
+                    std::cerr << "Survey " << label << ": " << e.what() << std::endl;
+                }
+            }
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Surveys: " << surveyCount << " in " << elapsed << " [s]" << '\n';
+            std::cout << "Report has been written to " << outputFile << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!conditionFile.empty()) {
+        try {
+            std::shared_future<std::shared_ptr<const ShipModel>> model = loadModel(soundingTables, hydrostaticTables, attachSegment);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            ConditionFileReader conditionReader(conditionFile);
+            if (format.empty()) {
+                format = "csv";
+            }
+            if (outputFile.empty()) {
+                outputFile = "Results." + format;
+            }
+            std::unique_ptr<ResultWriter> writer = ResultWriter::create(format, outputFile, includeCompartments);
+            std::unique_ptr<ConditionLog> log;
+            if (!logFile.empty()) {
+                log.reset(new ConditionLog(logFile, *model.get()));
+            }
+            const Precision precision = singlePrecision ? Precision::Single : Precision::Double;
+            if (!cacheFile.empty()) {
+                ResultCache cache;
+                cache.load(cacheFile, *model.get());
+                for (const ConditionDefinition& definition : conditionReader.getData()) {
+                    ShipResults results;
+                    if (log) {
+                        // A hit may hold the results of another condition that rounds to the same key; the log only records results
+                        // computed from the exact inputs, so the cache is bypassed and refreshed instead
+                        Ship myShip(model, definition);
+                        myShip.setPrecision(precision);
+                        results = myShip.getResults();
+                        cache.insert(definition, precision, results);
+                        log->append(definition, precision, results);
+                    }
+                    else {
+                        results = cache.evaluate(model.get(), definition, precision);
+                    }
+                    writer->write(definition.label, results, CompartmentProperties());
+                }
+                cache.save(cacheFile, *model.get());
+                CacheStatistics statistics = cache.getStatistics();
+                std::cout << "Cache hits: " << statistics.hits << ", misses: " << statistics.misses << ", evictions: " << statistics.evictions
+                    << ", entries: " << statistics.entries << '\n';
+            }
+            else {
+                std::unique_ptr<GrainStability> grain;
+                for (const ConditionDefinition& definition : conditionReader.getData()) {
+                    Ship myShip(model, definition);
+                    myShip.setPrecision(precision);
+                    if (grainCargo) {
+                        if (!grain) {
+                            grain.reset(new GrainStability(myShip.getModel()));
+                        }
+                        myShip.setGrainCargo(true);
+                        printGrainCheck(definition.label, myShip.checkGrain(*grain));
+                    }
+                    myShip.writeResults(*writer);
+                    if (log) {
+                        log->append(definition, precision, myShip.getResults());
+                    }
+                }
+            }
+            writer->flush();
+            if (log) {
+                log->flush();
+            }
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Conditions: " << conditionReader.getData().size() << " in " << elapsed << " [s]" << '\n';
+            std::cout << "Results have been appended to " << outputFile << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // DISCLAIMER: This code performs a first order approximation for the final equilibrium of the ship,
     // assuming the trim is equal to zero.
     // Having found an initial approximation for the trim of the ship, one can go back to SoundingTablesReader.h 
@@ -15,12 +438,215 @@ int main() {
     // For this reason, the code slightly underperforms (regarding the trim and heel angle) for loading conditions
     // for which free surface effects are prominent.
     // Prompt user for loading condition input.
+    // With structured output, several conditions separated by spaces are appended to the same stream
     std::cout << "Enter Loading Condition: ";
     std::getline(std::cin, userInput);
 
     try {
-        Ship myShip(trimStabilityBook, soundingTables, userInput, hydrostaticTables);
-        myShip.printResultsToFile();
+        if (!damageMethod.empty()) {
+            DamageMethod method;
+            if (damageMethod == "lost-buoyancy") {
+                method = DamageMethod::LostBuoyancy;
+            }
+            else if (damageMethod == "added-weight") {
+                method = DamageMethod::AddedWeight;
+            }
+            else {
+                throw std::runtime_error("Unknown damage method: " + damageMethod);
+            }
+            if (format.empty()) {
+                format = "csv";
+            }
+            if (outputFile.empty()) {
+                outputFile = "Damage." + format;
+            }
+            std::unique_ptr<ResultWriter> writer = ResultWriter::create(format, outputFile, false);
+
+            std::shared_future<std::shared_ptr<const ShipModel>> model = loadModel(soundingTables, hydrostaticTables, attachSegment);
+            std::vector<std::unique_ptr<Ship>> ships;
+            std::vector<const Ship*> shipPointers;
+            std::vector<std::string> labels;
+            std::istringstream conditions(userInput);
+            std::string condition;
+            while (conditions >> condition) {
+                ships.emplace_back(new Ship(model, trimStabilityBook, condition));
+                if (singlePrecision) {
+                    ships.back()->setPrecision(Precision::Single);
+                }
+                shipPointers.push_back(ships.back().get());
+                labels.push_back(condition);
+            }
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            DamageStability damageStability(*model.get());
+            std::vector<std::vector<size_t>> scenarios = damageStability.scenarioMatrix();
+            WorkStealingPool pool;
+            std::vector<DamageResult> damages = damageStability.run(shipPointers, scenarios, method, pool);
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            size_t unconverged = 0;
+            for (const DamageResult& damage : damages) {
+                writer->write(labels[damage.condition] + " " + damage.scenario, damage.results, CompartmentProperties());
+                if (!damage.converged) {
+                    ++unconverged;
+                }
+            }
+            writer->flush();
+            std::cout << "Scenarios: " << damages.size() << " (" << scenarios.size() << " per condition, " << unconverged << " not converged) in "
+                << elapsed << " [s] on " << pool.getThreadCount() << " threads" << '\n';
+            std::cout << "Results have been appended to " << outputFile << std::endl;
+        }
+        else if (exchange) {
+            if (format.empty()) {
+                format = "csv";
+            }
+            if (outputFile.empty()) {
+                outputFile = "Exchange." + format;
+            }
+            std::unique_ptr<ResultWriter> writer = ResultWriter::create(format, outputFile, false);
+            std::shared_future<std::shared_ptr<const ShipModel>> model = loadModel(soundingTables, hydrostaticTables, attachSegment);
+            WorkStealingPool pool;
+            std::istringstream conditions(userInput);
+            std::string condition;
+            while (conditions >> condition) {
+                Ship myShip(model, trimStabilityBook, condition);
+                if (singlePrecision) {
+                    myShip.setPrecision(Precision::Single);
+                }
+                BallastExchangePlanner planner(myShip);
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                ExchangePlan plan = planner.plan(pool);
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << "Loading Condition " << condition << ": " << planner.getTanks().size() << " ballast tanks, "
+                    << (plan.feasible ? std::to_string(plan.steps.size()) + " steps, margin " + std::to_string(plan.margin) : std::string("no feasible sequence found"))
+                    << " (" << plan.evaluations << " conditions evaluated in " << elapsed << " [s])" << '\n';
+                for (size_t s = 0; s < plan.steps.size(); ++s) {
+                    const ExchangeStep& step = plan.steps[s];
+                    std::string tanks;
+                    for (const std::string& tank : step.refilled) {
+                        tanks += " +" + tank;
+                    }
+                    for (const std::string& tank : step.emptied) {
+                        tanks += " -" + tank;
+                    }
+                    std::cout << "  Step " << (s + 1) << ":" << tanks << '\n';
+                    writer->write(condition + " " + std::to_string(s + 1) + " halfway", step.halfway, CompartmentProperties());
+                    writer->write(condition + " " + std::to_string(s + 1) + " end", step.end, CompartmentProperties());
+                }
+            }
+            writer->flush();
+            std::cout << "Results have been appended to " << outputFile << std::endl;
+        }
+        else if (!routeFile.empty()) {
+            if (outputFile.empty()) {
+                outputFile = "Voyage.csv";
+            }
+            VoyageSimulation voyage(routeFile);
+            std::shared_future<std::shared_ptr<const ShipModel>> model = loadModel(soundingTables, hydrostaticTables, attachSegment);
+            std::vector<std::unique_ptr<Ship>> ships;
+            std::vector<const Ship*> shipPointers;
+            std::vector<std::string> labels;
+            std::istringstream conditions(userInput);
+            std::string condition;
+            while (conditions >> condition) {
+                ships.emplace_back(new Ship(model, trimStabilityBook, condition));
+                if (singlePrecision) {
+                    ships.back()->setPrecision(Precision::Single);
+                }
+                shipPointers.push_back(ships.back().get());
+                labels.push_back(condition);
+            }
+
+            std::ifstream existing(outputFile);
+            const bool writeHeader = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+            existing.close();
+            std::ofstream output(outputFile, std::ios::app);
+            if (!output.is_open()) {
+                throw std::runtime_error("Failed to open " + outputFile + " for writing.");
+            }
+            if (writeHeader) {
+                VoyageSimulation::writeHeader(output);
+            }
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            WorkStealingPool pool;
+            std::vector<VoyageSummary> summaries = voyage.run(shipPointers, labels, &output, pool);
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            size_t steps = 0;
+            for (const VoyageSummary& summary : summaries) {
+                steps += summary.steps;
+                std::cout << "Loading Condition " << summary.label << ": minimum UKC " << summary.minimumUKC << " [m] at " << summary.timeOfMinimum
+                    << " [h], " << summary.distanceOfMinimum << " [nm]; arrival TF " << summary.arrival.TF << " TA " << summary.arrival.TA << " [m]" << '\n';
+            }
+            std::cout << "Steps: " << steps << " in " << elapsed << " [s] on " << pool.getThreadCount() << " threads" << '\n';
+            std::cout << "Results have been appended to " << outputFile << std::endl;
+        }
+        else if (!gaugeRecords.empty()) {
+            if (format.empty()) {
+                format = "csv";
+            }
+            if (outputFile.empty()) {
+                outputFile = "Results." + format;
+            }
+            std::unique_ptr<ResultWriter> writer = ResultWriter::create(format, outputFile, includeCompartments);
+            // The ship is built once; every record only updates the gauged tank and the equilibrium
+            Ship myShip(loadModel(soundingTables, hydrostaticTables, attachSegment), trimStabilityBook, userInput);
+            if (singlePrecision) {
+                myShip.setPrecision(Precision::Single);
+            }
+            GaugeStream stream(myShip, *writer);
+            if (gaugeRecords == "-") {
+                stream.run(std::cin);
+            }
+            else {
+                std::ifstream records(gaugeRecords);
+                if (!records.is_open()) {
+                    throw std::runtime_error("Failed to open " + gaugeRecords + " for reading.");
+                }
+                stream.run(records);
+            }
+            LatencyStatistics statistics = stream.getStatistics();
+            std::cout << "Updates: " << statistics.updates << " (" << statistics.rejected << " rejected) in " << statistics.elapsed << " [s]" << '\n';
+            std::cout << "Latency mean/p50/p99/max: " << statistics.mean << " / " << statistics.p50 << " / " << statistics.p99 << " / " << statistics.max << " [us]" << '\n';
+            std::cout << "Results have been appended to " << outputFile << std::endl;
+        }
+        else if (format.empty()) {
+            Ship myShip(loadModel(soundingTables, hydrostaticTables, attachSegment), trimStabilityBook, userInput);
+            if (singlePrecision) {
+                myShip.setPrecision(Precision::Single);
+            }
+            if (grainCargo) {
+                myShip.setGrainCargo(true);
+                printGrainCheck(userInput, myShip.checkGrain(GrainStability(myShip.getModel())));
+            }
+            myShip.printResultsToFile();
+        }
+        else {
+            if (outputFile.empty()) {
+                outputFile = "Results." + format;
+            }
+            std::unique_ptr<ResultWriter> writer = ResultWriter::create(format, outputFile, includeCompartments);
+            // The model is loaded once, in the background, and shared by every condition
+            std::shared_future<std::shared_ptr<const ShipModel>> model = loadModel(soundingTables, hydrostaticTables, attachSegment);
+            std::unique_ptr<GrainStability> grain;
+            std::istringstream conditions(userInput);
+            std::string condition;
+            while (conditions >> condition) {
+                Ship myShip(model, trimStabilityBook, condition);
+                if (singlePrecision) {
+                    myShip.setPrecision(Precision::Single);
+                }
+                if (grainCargo) {
+                    if (!grain) {
+                        grain.reset(new GrainStability(myShip.getModel()));
+                    }
+                    myShip.setGrainCargo(true);
+                    printGrainCheck(condition, myShip.checkGrain(*grain));
+                }
+                myShip.writeResults(*writer);
+            }
+            writer->flush();
+            std::cout << "Results have been appended to " << outputFile << std::endl;
+        }
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -1,79 +1,164 @@
 #include "LoadingCondition.h"
 
 // Implementing the constructor
-LoadingCondition::LoadingCondition(const std::string& trimStabilityBook, const std::string& soundingTables, const std::string& userInput)
-    : trimStabilityBook(trimStabilityBook), soundingTables(soundingTables), userInput(userInput) {
+LoadingCondition::LoadingCondition(const std::string& trimStabilityBook, const std::string& userInput)
+    : trimStabilityBook(trimStabilityBook), userInput(userInput), precision(Precision::Double) {
     try {
         // Instantiate trimStabilityReader and get tankPlan and densities
         TrimStabilityReader trimReader(trimStabilityBook, userInput);
         tankPlan = trimReader.getData();
         densities = trimReader.getDensities(); // Retrieve densities array
+        floatingCondition = trimReader.getFloatingCondition();
     }
     catch (const std::exception& e) {
         throw std::runtime_error("Error instantiating TrimStabilityReader.");
     }
 }
 
+// Implementing the constructor for a condition file
+LoadingCondition::LoadingCondition(const ConditionDefinition& definition)
+    : userInput(definition.label), tankPlan(definition.tankPlan), densities(definition.densities), precision(Precision::Double) {
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+    floatingCondition = { missing, missing, missing, missing, missing, missing };
+}
+
+// Implementing the checkFills method
+void LoadingCondition::checkFills(const ShipModel& model, const ConditionDefinition& definition) {
+    for (const std::string& key : definition.fills) {
+        if (key.compare(0, 3, "R1.") == 0) {
+            // Cargo holds are numbered by the single digit after "R1."
+            if (key.size() != 4 || key[3] < '1' || key[3] - '0' > ShipModel::holdCount) {
+                throw std::runtime_error("Unknown cargo hold " + key + " in condition " + definition.label);
+            }
+        }
+        else if (model.getSoundingTable(key).empty()) {
+            throw std::runtime_error("No sounding table for " + key + " in condition " + definition.label);
+        }
+    }
+    for (const std::string& name : definition.items) {
+        if (!model.getSoundingTable(name).empty()) {
+            throw std::runtime_error("Item " + name + " has a sounding table and must be given as a fill in condition " + definition.label);
+        }
+    }
+}
+
 // Implementing the calculate method
-void LoadingCondition::calculate() {
-    try {
-        // Instantiate SoundingTablesReader to use for interpolation
-        SoundingTablesReader soundingReader(soundingTables, tankPlan);
+void LoadingCondition::calculate(const ShipModel& model) {
+    calculateCompartments(model, nullptr);
+}
 
-        // Process each key in tankPlan
-        for (const auto& pair : tankPlan) {
-            const std::string& key = pair.first;
-            try {
-                // Keys corresponding to cargo holds
-                if (key.size() >= 4 && key.substr(0, 3) == "R1.") {
-                    double volume, lcg, tcg, vcg, fsm;
-                    std::tie(volume, lcg, tcg, vcg, fsm) = cargoHoldsCalculations(key, tankPlan);
+// Implementing the calculate method for gauge readings
+void LoadingCondition::calculate(const ShipModel& model, const std::unordered_map<std::string, double>& soundings, double trim) {
+    calculateCompartments(model, &soundings);
+
+    if (!soundings.empty()) {
+        std::vector<std::string> keys;
+        std::vector<double> values;
+        for (const auto& pair : soundings) {
+            if (tankPlan.find(pair.first) == tankPlan.end()) {
+                throw std::runtime_error("Gauge reading for compartment not in the loading condition: " + pair.first);
+            }
+            keys.push_back(pair.first);
+            values.push_back(pair.second);
+        }
+        SoundingTrimTable soundingTrimTable(model, keys);
+        SoundingResults results;
+        soundingTrimTable.interpolate(values, trim, results);
+        for (size_t k = 0; k < keys.size(); ++k) {
+            double density = getDensity(keys[k]);
+            tankProperties[keys[k]] = std::make_tuple(density * results.volume[k], results.lcg[k], results.tcg[k], results.vcg[k], density * results.IMOM[k]);
+        }
+    }
+}
+
+// Implementing the calculateCompartments method
+// Compartments with a gauge reading in soundings are skipped
+void LoadingCondition::calculateCompartments(const ShipModel& model, const std::unordered_map<std::string, double>* soundings) {
+    // Process each key in tankPlan
+    for (const auto& pair : tankPlan) {
+        const std::string& key = pair.first;
+        if (soundings && soundings->count(key) != 0) {
+            continue;
+        }
+        try {
+            // Keys corresponding to cargo holds
+            if (key.size() >= 4 && key.compare(0, 3, "R1.") == 0) {
+                double volume, lcg, tcg, vcg, fsm;
+                std::tie(volume, lcg, tcg, vcg, fsm) = cargoHoldsCalculations(model, key, tankPlan);
+                double density = getDensity(key);
+                double mass = density * volume;
+                // Store results for mass, LCG, TCG, VCG and FSM
+                tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, density * fsm);
+            }
+            // Remaining keys, excluding "Floating Condition"
+            else if (key != "Floating Condition") {
+                // Check if key can be found in soundingData for interpolation
+                TableView<SoundingTableSchema> soundingData = model.getSoundingTable(key);
+                // Keys corresponding to tanks for which sounding tables are available
+                if (!soundingData.empty()) {
+                    double volume, lcg, tcg, vcg, IMOM;
+                    double fillPercentage = pair.second[1];
+                    if (precision == Precision::Single) {
+                        std::tie(volume, lcg, tcg, vcg, IMOM) = tanksCalculations(model.getSoundingTable<float>(key), fillPercentage);
+                    }
+                    else {
+                        std::tie(volume, lcg, tcg, vcg, IMOM) = tanksCalculations(soundingData, fillPercentage);
+                    }
                     double density = getDensity(key);
                     double mass = density * volume;
-                    // Store results for mass, LCG, TCG, VCG and FSM
+                    double fsm = density * IMOM;
                     tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, fsm);
                 }
-                // Remaining keys, excluding "Floating Condition"
-                else if (key != "Floating Condition") {
-                    // Check if key can be found in soundingData for interpolation
-                    std::vector<std::vector<double>> soundingData = soundingReader.getData(key);
-                    // Keys corresponding to tanks for which sounding tables are available
-                    if (!soundingData.empty()) {
-                        double volume, lcg, tcg, vcg, IMOM;
-                        double fillPercentage = pair.second[1];
-                        std::tie(volume, lcg, tcg, vcg, IMOM) = tanksCalculations(soundingData, fillPercentage);
-                        double density = getDensity(key);
-                        double mass = density * volume;
-                        double fsm = density * IMOM;
-                        tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, fsm);
-                    }
-                    else if (key != "Lightweight") {
-                        // Draw values directly from tankPlan
-                        double mass = pair.second[0];
-                        double lcg = pair.second[2];
-                        double tcg = pair.second[3];
-                        double vcg = pair.second[4];
-                        double fsm = pair.second[5];
-                        tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, fsm);
-                    }
-                    else {
-                        // Draw values directly from tankPlan
-                        double mass = pair.second[0];
-                        double lcg = pair.second[1];
-                        double tcg = pair.second[2];
-                        double vcg = pair.second[3];
-                        tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, 0);
-                    }
+                else if (key != "Lightweight") {
+                    // Draw values directly from tankPlan
+                    double mass = pair.second[0];
+                    double lcg = pair.second[2];
+                    double tcg = pair.second[3];
+                    double vcg = pair.second[4];
+                    double fsm = pair.second[5];
+                    tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, fsm);
+                }
+                else {
+                    // Draw values directly from tankPlan
+                    double mass = pair.second[0];
+                    double lcg = pair.second[1];
+                    double tcg = pair.second[2];
+                    double vcg = pair.second[3];
+                    tankProperties[key] = std::make_tuple(mass, lcg, tcg, vcg, 0);
                 }
             }
-            catch (const std::exception& e) {
-                throw std::runtime_error("Unable to calculate properties of compartment: " + key);
+        }
+        catch (const std::exception& e) {
+            throw std::runtime_error("Unable to calculate properties of compartment: " + key);
+        }
+    }
+}
+
+// Implementing the updateSounding method
+const std::tuple<double, double, double, double, double>& LoadingCondition::updateSounding(const ShipModel& model, const std::string& key, double sounding, double trim) {
+    if (!gaugeTable) {
+        std::vector<std::string> keys;
+        for (const auto& pair : tankPlan) {
+            const std::string& tank = pair.first;
+            if (tank.compare(0, 3, "R1.") != 0 && !model.getSoundingTable(tank).empty()) {
+                keys.push_back(tank);
             }
         }
+        std::sort(keys.begin(), keys.end());
+        gaugeTable.reset(new SoundingTrimTable(model, keys));
     }
-    catch (const std::exception& e) {
-        throw std::runtime_error("Error instantiating SoundingTablesReader.");
+
+    size_t tank = gaugeTable->find(key);
+    auto it = tankProperties.find(key);
+    if (tank == SoundingTrimTable::npos || it == tankProperties.end()) {
+        throw std::runtime_error("No sounding table for gauged compartment: " + key);
     }
+
+    double volume, lcg, tcg, vcg, IMOM;
+    std::tie(volume, lcg, tcg, vcg, IMOM) = gaugeTable->interpolate(tank, sounding, trim);
+    double density = getDensity(key);
+    it->second = std::make_tuple(density * volume, lcg, tcg, vcg, density * IMOM);
+    return it->second;
 }
 
 // Implementing the getData method
@@ -81,118 +166,93 @@ const std::unordered_map<std::string, std::tuple<double, double, double, double,
     return tankProperties;
 }
 
-// Implementing the tanksCalculations method
-std::tuple<double, double, double, double, double> LoadingCondition::tanksCalculations(std::vector<std::vector<double>> soundingData, double fillPercentage) const {
-    double volume = 0.0, lcg = 0.0, tcg = 0.0, vcg = 0.0, IMOM = 0.0;
-    // Ensure soundingData has at least two rows for interpolation
-    if (soundingData.size() < 2) {
-        throw std::runtime_error("Insufficient data for interpolation.");
-    }
-    // Find the rows for which interpolation is to be performed
-    size_t idx1 = 0, idx2 = 1;
-    double diff1 = std::abs(soundingData[idx1][8] - fillPercentage);
-    double diff2 = std::abs(soundingData[idx2][8] - fillPercentage);
-    for (size_t i = 2; i < soundingData.size(); ++i) {
-        double currentDiff = std::abs(soundingData[i][8] - fillPercentage);
-        if (currentDiff < diff1) {
-            idx2 = idx1;
-            idx1 = i;
-            diff2 = diff1;
-            diff1 = currentDiff;
-        }
-        else if (currentDiff < diff2) {
-            idx2 = i;
-            diff2 = currentDiff;
-        }
+// Implementing the getFloatingCondition method
+const FloatingCondition& LoadingCondition::getFloatingCondition() const {
+    return floatingCondition;
+}
+
+// Implementing the getFillPercentage method
+double LoadingCondition::getFillPercentage(const std::string& key) const {
+    auto it = tankPlan.find(key);
+    if (it == tankPlan.end() || it->second.size() < 2) {
+        return 0.0;
     }
-    // Ensure no division by zero
-    if (soundingData[idx2][8] != soundingData[idx1][8]) {
-        // Perform linear interpolations for volume, LCG, TCG, VCG and IMOM columns
-        double value1 = soundingData[idx1][1];
-        double value2 = soundingData[idx2][1];
-        double fraction = (fillPercentage - soundingData[idx1][8]) / (soundingData[idx2][8] - soundingData[idx1][8]);
-        volume = value1 + fraction * (value2 - value1);
-
-        value1 = soundingData[idx1][9];
-        value2 = soundingData[idx2][9];
-        lcg = value1 + fraction * (value2 - value1);
-
-        value1 = soundingData[idx1][10];
-        value2 = soundingData[idx2][10];
-        tcg = value1 + fraction * (value2 - value1);
-
-        value1 = soundingData[idx1][11];
-        value2 = soundingData[idx2][11];
-        vcg = value1 + fraction * (value2 - value1);
-
-        value1 = soundingData[idx1][12];
-        value2 = soundingData[idx2][12];
-        IMOM = value1 + fraction * (value2 - value1);
-        if (IMOM < 0) {
-            IMOM = 0;
-        }
+    return it->second[1];
+}
+
+// Implementing the evaluateFill method
+std::tuple<double, double, double, double, double> LoadingCondition::evaluateFill(const ShipModel& model, const std::string& key, double fillPercentage) const {
+    TableView<SoundingTableSchema> soundingData = model.getSoundingTable(key);
+    if (soundingData.empty()) {
+        throw std::runtime_error("No sounding table for compartment: " + key);
+    }
+    double volume, lcg, tcg, vcg, IMOM;
+    if (precision == Precision::Single) {
+        std::tie(volume, lcg, tcg, vcg, IMOM) = tanksCalculations(model.getSoundingTable<float>(key), fillPercentage);
     }
     else {
-        volume = soundingData[idx1][1];
-        lcg = soundingData[idx1][9];
-        tcg = soundingData[idx1][10];
-        vcg = soundingData[idx1][11];
-        IMOM = soundingData[idx1][12];
+        std::tie(volume, lcg, tcg, vcg, IMOM) = tanksCalculations(soundingData, fillPercentage);
+    }
+    double density = getDensity(key);
+    return std::make_tuple(density * volume, lcg, tcg, vcg, density * IMOM);
+}
+
+// Implementing the tanksCalculations method
+template <class Value>
+std::tuple<double, double, double, double, double> LoadingCondition::tanksCalculations(TableView<SoundingTableSchema, Value> soundingData, double fillPercentage) const {
+    double volume, lcg, tcg, vcg, IMOM;
+    // Perform linear interpolations for volume, LCG, TCG, VCG and IMOM columns
+    std::tie(volume, lcg, tcg, vcg, IMOM) = interpolateNearest<SoundingTableSchema, SoundingTableSchema::Fill,
+        SoundingTableSchema::Volume, SoundingTableSchema::LCG, SoundingTableSchema::TCG, SoundingTableSchema::VCG, SoundingTableSchema::IMOM>(soundingData, fillPercentage);
+    if (IMOM < 0) {
+        IMOM = 0;
     }
 
     return std::make_tuple(volume, lcg, tcg, vcg, IMOM);
 }
 
 // Implementing the cargoHoldsCalculations method
-std::tuple<double, double, double, double, double> LoadingCondition::cargoHoldsCalculations(const std::string& key, const std::unordered_map<std::string, std::vector<double>>& tankPlan) const {
-    double volume = 0.0, lcg = 0.0, tcg = 0.0, vcg = 0.0, fsm = 0.0;
+std::tuple<double, double, double, double, double> LoadingCondition::cargoHoldsCalculations(const ShipModel& model, const std::string& key, const std::unordered_map<std::string, std::vector<double>>& tankPlan) const {
     // Fourth character in the key corresponds to the hold number
     char holdNumber = key[3];
-    if (isdigit(holdNumber)) {
-        std::string fileName = "Data/Cargo hold data/Hold (" + std::string(1, holdNumber) + ").txt";
-        CargoHoldReader holdReader(fileName);
-        const auto& cargoData = holdReader.getData();
-        double fillPercentage = tankPlan.at(key)[1];
-        double maxCargo = cargoData[11][1]; // Accessing the 12th row of the 2nd column
-        volume = fillPercentage * maxCargo / 100.0;
-        // Find the rows for which interpolation is to be performed
-        size_t idx1 = 0, idx2 = 1;
-        double diff1 = std::abs(cargoData[idx1][1] - volume);
-        double diff2 = std::abs(cargoData[idx2][1] - volume);
-        for (size_t i = 2; i < cargoData.size(); ++i) {
-            double currentDiff = std::abs(cargoData[i][1] - volume);
-            if (currentDiff < diff1) {
-                idx2 = idx1;
-                idx1 = i;
-                diff2 = diff1;
-                diff1 = currentDiff;
-            }
-            else if (currentDiff < diff2) {
-                idx2 = i;
-                diff2 = currentDiff;
-            }
-        }
-        // Perform linear interpolations for LCG, TCG, VCG, FSM columns
-        double value1 = cargoData[idx1][2];
-        double value2 = cargoData[idx2][2];
-        double fraction = (volume - cargoData[idx1][1]) / (cargoData[idx2][1] - cargoData[idx1][1]);
-        lcg = value1 + fraction * (value2 - value1);
-
-        value1 = cargoData[idx1][3];
-        value2 = cargoData[idx2][3];
-        tcg = value1 + fraction * (value2 - value1);
-
-        value1 = cargoData[idx1][4];
-        value2 = cargoData[idx2][4];
-        vcg = value1 + fraction * (value2 - value1);
-    }
-    else {
+    if (!isdigit(holdNumber)) {
         throw std::invalid_argument("Invalid key format.");
     }
+    double fillPercentage = tankPlan.at(key)[1];
+    if (precision == Precision::Single) {
+        return holdCalculations(model.getCargoHold<float>(holdNumber - '0'), key, fillPercentage);
+    }
+    return holdCalculations(model.getCargoHold(holdNumber - '0'), key, fillPercentage);
+}
+
+// Implementing the holdCalculations method
+template <class Value>
+std::tuple<double, double, double, double, double> LoadingCondition::holdCalculations(TableView<CargoHoldSchema, Value> cargoData, const std::string& key, double fillPercentage) const {
+    double volume = 0.0, lcg = 0.0, tcg = 0.0, vcg = 0.0, fsm = 0.0;
+    if (cargoData.empty()) {
+        throw std::runtime_error("No cargo hold data for " + key);
+    }
+    double maxCargo = cargoData.back()[CargoHoldSchema::Volume::index]; // Last row holds the full capacity
+    volume = fillPercentage * maxCargo / 100.0;
+    // Perform linear interpolations for LCG, TCG, VCG and FSM columns
+    // The FSM column is the transverse moment of inertia of the cargo surface [m4], so it is scaled by the density like the IMOM of the tanks
+    std::tie(lcg, tcg, vcg, fsm) = interpolateNearest<CargoHoldSchema, CargoHoldSchema::Volume,
+        CargoHoldSchema::LCG, CargoHoldSchema::TCG, CargoHoldSchema::VCG, CargoHoldSchema::FSM>(cargoData, volume);
+    fsm = std::max(fsm, 0.0);
 
     return std::make_tuple(volume, lcg, tcg, vcg, fsm);
 }
 
+// Implementing the setPrecision method
+void LoadingCondition::setPrecision(Precision precision) {
+    this->precision = precision;
+}
+
+// Implementing the getPrecision method
+Precision LoadingCondition::getPrecision() const {
+    return precision;
+}
+
 // Implementing the getDensity method
 double LoadingCondition::getDensity(const std::string& key) const {
     char densityIndexChar = key[1]; // Assuming key format is "RX.Y"
@@ -2,36 +2,79 @@
 #define LOADINGCONDITION_H
 
 #include "TrimStabilityReader.h"
-#include "SoundingTablesReader.h"
-#include "CargoHoldReader.h"
+#include "ConditionFileReader.h"
+#include "ShipModel.h"
+#include "SoundingTrimTable.h"
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <iostream>
 #include <sstream>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 
 class LoadingCondition {
 public:
-    LoadingCondition(const std::string& trimStabilityBook, const std::string& soundingTables, const std::string& userInput);
+    LoadingCondition(const std::string& trimStabilityBook, const std::string& userInput);
 
-    void calculate();
+    // Condition read from a condition file rather than the book; it has no Floating Condition block to compare against
+    explicit LoadingCondition(const ConditionDefinition& definition);
+
+    // Throws if a compartment filled by percentage is neither a cargo hold of the model nor a tank with a sounding table,
+    // which would otherwise be taken for a deadweight item of no mass, or if an item names a tank with a sounding table,
+    // whose mass would otherwise be read as a fill percentage
+    static void checkFills(const ShipModel& model, const ConditionDefinition& definition);
+
+    // Once every compartment has been evaluated, further calls perform no heap allocation
+    void calculate(const ShipModel& model);
+
+    // Tanks listed in soundings are evaluated from gauge readings (cm) at the given trim, instead of their fill percentage
+    void calculate(const ShipModel& model, const std::unordered_map<std::string, double>& soundings, double trim);
+
+    // Re-evaluates a single tank from a gauge reading (cm) at the given trim, leaving every other compartment untouched
+    // Returns the new mass, LCG, TCG, VCG and FSM of the tank
+    const std::tuple<double, double, double, double, double>& updateSounding(const ShipModel& model, const std::string& key, double sounding, double trim);
 
     const std::unordered_map<std::string, std::tuple<double, double, double, double, double>>& getData() const;
 
+    // Equilibrium printed by the book for this condition
+    const FloatingCondition& getFloatingCondition() const;
+
+    // Density of the contents of the compartment, from the group digit of its key [t/m3]
+    double getDensity(const std::string& key) const;
+
+    // Fill percentage of a compartment in the tank plan, zero if it is not in the loading condition
+    double getFillPercentage(const std::string& key) const;
+
+    // Mass, LCG, TCG, VCG and FSM the tank would have at another fill percentage, leaving the condition untouched
+    std::tuple<double, double, double, double, double> evaluateFill(const ShipModel& model, const std::string& key, double fillPercentage) const;
+
+    // Precision of the table interpolations of calculate and evaluateFill; gauge updates are always interpolated in double precision
+    void setPrecision(Precision precision);
+
+    Precision getPrecision() const;
+
 private:
     std::string trimStabilityBook;
-    std::string soundingTables;
     std::string userInput;
     std::unordered_map<std::string, std::vector<double>> tankPlan;
     std::vector<double> densities;
+    FloatingCondition floatingCondition;
+    Precision precision;
     std::unordered_map<std::string, std::tuple<double, double, double, double, double>> tankProperties;
-    
-    std::tuple<double, double, double, double, double> tanksCalculations(std::vector<std::vector<double>> soundingData, double fillPercentage) const;
+    // Sounding tables of every gauged tank in the condition, built on the first gauge update
+    std::unique_ptr<SoundingTrimTable> gaugeTable;
 
-    std::tuple<double, double, double, double, double> cargoHoldsCalculations(const std::string& key, const std::unordered_map<std::string, std::vector<double>>& tankPlan) const;
+    void calculateCompartments(const ShipModel& model, const std::unordered_map<std::string, double>* soundings);
 
-    double getDensity(const std::string& key) const;
+    template <class Value>
+    std::tuple<double, double, double, double, double> tanksCalculations(TableView<SoundingTableSchema, Value> soundingData, double fillPercentage) const;
+
+    std::tuple<double, double, double, double, double> cargoHoldsCalculations(const ShipModel& model, const std::string& key, const std::unordered_map<std::string, std::vector<double>>& tankPlan) const;
+
+    template <class Value>
+    std::tuple<double, double, double, double, double> holdCalculations(TableView<CargoHoldSchema, Value> cargoData, const std::string& key, double fillPercentage) const;
 };
 
 #endif // LOADINGCONDITION_H
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef PDFLIBRARY_H
+#define PDFLIBRARY_H
+
+#include <mutex>
+#include <fpdfview.h>
+
+// Initializes PDFium for the lifetime of the object
+// PDFium is not thread-safe, so readers running on different threads take turns through a shared lock
+class PdfLibrary {
+public:
+    PdfLibrary() : lock(libraryMutex()) {
+        FPDF_InitLibrary();
+    }
+
+    ~PdfLibrary() {
+        FPDF_DestroyLibrary();
+    }
+
+    PdfLibrary(const PdfLibrary&) = delete;
+    PdfLibrary& operator=(const PdfLibrary&) = delete;
+
+private:
+    std::lock_guard<std::mutex> lock;
+
+    static std::mutex& libraryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+};
+
+#endif // PDFLIBRARY_H
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "RegressionHarness.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+    // Quantities compared with the book, as (name, computed, book) accessors
+    struct Quantity {
+        const char* name;
+        double ShipResults::* computed;
+        double FloatingCondition::* book;
+    };
+
+    const Quantity quantities[] = {
+        { "draught_moulded", &ShipResults::draughtMoulded, &FloatingCondition::draughtMoulded },
+        { "tf", &ShipResults::TF, &FloatingCondition::TF },
+        { "ta", &ShipResults::TA, &FloatingCondition::TA },
+        { "trim", &ShipResults::trim, &FloatingCondition::trim },
+        { "heel", &ShipResults::heel, &FloatingCondition::heel },
+        { "gm", &ShipResults::GM, &FloatingCondition::GM }
+    };
+}
+
+// Implementing the constructor
+RegressionHarness::RegressionHarness(const std::string& trimStabilityBook, const std::string& soundingTables, const std::string& hydrostaticTables,
+    const RegressionTolerances& tolerances)
+    : trimStabilityBook(trimStabilityBook), soundingTables(soundingTables), hydrostaticTables(hydrostaticTables), tolerances(tolerances), modelLoadTime(0.0) {
+}
+
+// Implementing the run method
+const std::vector<RegressionResult>& RegressionHarness::run() {
+    results.clear();
+
+    // The model is loaded once and timed on its own, so that condition timings only cover the book and the evaluation
+    Clock::time_point start = Clock::now();
+    std::shared_ptr<const ShipModel> model = ShipModel::loadAsync(soundingTables, hydrostaticTables).get();
+    modelLoadTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    for (int i = 1; i <= conditionCount; ++i) {
+        char condition[3];
+        sprintf_s(condition, sizeof(condition), "%02d", i);
+
+        RegressionResult result = RegressionResult();
+        result.condition = condition;
+        try {
+            start = Clock::now();
+            Ship ship(model, trimStabilityBook, condition);
+            result.totalTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            start = Clock::now();
+            for (int k = 0; k < evaluationRepeats; ++k) {
+                ship.evaluate();
+            }
+            result.evaluateTime = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / evaluationRepeats;
+
+            result.computed = ship.getResults();
+
+            ship.setPrecision(Precision::Single);
+            start = Clock::now();
+            for (int k = 0; k < evaluationRepeats; ++k) {
+                ship.evaluate();
+            }
+            result.singleEvaluateTime = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / evaluationRepeats;
+            result.single = ship.getResults();
+            result.book = ship.getBookCondition();
+            result.unchecked = true;
+            for (const Quantity& quantity : quantities) {
+                if (!std::isnan(result.book.*quantity.book)) {
+                    result.unchecked = false;
+                }
+            }
+            // A condition without book values has been compared with nothing, so it cannot pass
+            result.passed = !result.unchecked && withinTolerances(result.computed, result.book);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Condition " << condition << ": " << e.what() << std::endl;
+            const double missing = std::numeric_limits<double>::quiet_NaN();
+            result.book = { missing, missing, missing, missing, missing, missing };
+            result.passed = false;
+        }
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+// Implementing the writeReport method
+void RegressionHarness::writeReport(const std::string& fileName) const {
+    std::ofstream outFile(fileName);
+    if (!outFile.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for writing.");
+    }
+
+    outFile << "condition,status,total_ms,evaluate_us";
+    for (const Quantity& quantity : quantities) {
+        outFile << ',' << quantity.name << ',' << quantity.name << "_book," << quantity.name << "_error";
+    }
+    outFile << ",evaluate_single_us";
+    for (const Quantity& quantity : quantities) {
+        outFile << ',' << quantity.name << "_single_deviation";
+    }
+    outFile << '\n';
+
+    char number[32];
+    for (const RegressionResult& result : results) {
+        outFile << result.condition << ',' << (result.unchecked ? "unchecked" : (result.passed ? "pass" : "fail"));
+        snprintf(number, sizeof(number), ",%.3f,%.3f", result.totalTime, result.evaluateTime);
+        outFile << number;
+        for (const Quantity& quantity : quantities) {
+            double computed = result.computed.*quantity.computed;
+            double book = result.book.*quantity.book;
+            snprintf(number, sizeof(number), ",%.4f", computed);
+            outFile << number;
+            if (std::isnan(book)) {
+                outFile << ",,";
+            }
+            else {
+                snprintf(number, sizeof(number), ",%.4f,%.4f", book, computed - book);
+                outFile << number;
+            }
+        }
+        snprintf(number, sizeof(number), ",%.3f", result.singleEvaluateTime);
+        outFile << number;
+        for (const Quantity& quantity : quantities) {
+            snprintf(number, sizeof(number), ",%.3e", result.single.*quantity.computed - result.computed.*quantity.computed);
+            outFile << number;
+        }
+        outFile << '\n';
+    }
+}
+
+// Implementing the printSummary method
+void RegressionHarness::printSummary(std::ostream& output) const {
+    size_t unchecked = 0;
+    double totalTime = 0.0, evaluateTime = 0.0, singleEvaluateTime = 0.0;
+    for (const RegressionResult& result : results) {
+        if (result.unchecked) {
+            ++unchecked;
+        }
+        totalTime += result.totalTime;
+        evaluateTime += result.evaluateTime;
+        singleEvaluateTime += result.singleEvaluateTime;
+    }
+
+    output << "Conditions: " << results.size() << ", failed: " << getFailureCount() << ", without book values: " << unchecked << '\n';
+    if (!results.empty() && unchecked == results.size()) {
+        output << "No Floating Condition values were read from the book: nothing has been compared" << '\n';
+    }
+    else if (unchecked > 0) {
+        output << unchecked << " conditions without Floating Condition values in the book count as failed" << '\n';
+    }
+    output << "Model loading: " << modelLoadTime << " [ms], conditions: " << totalTime << " [ms], mean evaluation: "
+        << (results.empty() ? 0.0 : evaluateTime / results.size()) << " [us], in single precision: "
+        << (results.empty() ? 0.0 : singleEvaluateTime / results.size()) << " [us]" << '\n';
+    for (const Quantity& quantity : quantities) {
+        double maxError = 0.0;
+        for (const RegressionResult& result : results) {
+            double book = result.book.*quantity.book;
+            if (!std::isnan(book)) {
+                maxError = std::max(maxError, std::abs(result.computed.*quantity.computed - book));
+            }
+        }
+        output << "Largest " << quantity.name << " error: " << maxError << '\n';
+    }
+    for (const Quantity& quantity : quantities) {
+        double maxDeviation = 0.0;
+        for (const RegressionResult& result : results) {
+            double deviation = std::abs(result.single.*quantity.computed - result.computed.*quantity.computed);
+            if (!std::isnan(deviation)) {
+                maxDeviation = std::max(maxDeviation, deviation);
+            }
+        }
+        output << "Largest single precision " << quantity.name << " deviation: " << maxDeviation << '\n';
+    }
+}
+
+// Implementing the getFailureCount method
+size_t RegressionHarness::getFailureCount() const {
+    return std::count_if(results.begin(), results.end(), [](const RegressionResult& result) { return !result.passed; });
+}
+
+// Implementing the withinTolerances method
+// Quantities missing from the book are not compared
+bool RegressionHarness::withinTolerances(const ShipResults& computed, const FloatingCondition& book) const {
+    const double limits[] = { tolerances.draught, tolerances.draught, tolerances.draught, tolerances.trim, tolerances.heel, tolerances.GM };
+    size_t k = 0;
+    for (const Quantity& quantity : quantities) {
+        double limit = limits[k++];
+        if (std::isnan(book.*quantity.book)) {
+            continue;
+        }
+        if (!(std::abs(computed.*quantity.computed - book.*quantity.book) <= limit)) {
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
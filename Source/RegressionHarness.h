@@ -0,0 +1,69 @@
+#ifndef REGRESSIONHARNESS_H
+#define REGRESSIONHARNESS_H
+
+#include "Ship.h"
+#include "ShipModel.h"
+#include "ResultWriter.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <fstream>
+#include <stdexcept>
+
+// Largest accepted deviations of the computed equilibrium from the book
+struct RegressionTolerances {
+    double draught = 0.05; // Draught moulded, TF and TA [m]
+    double trim = 0.10; // [m]
+    double heel = 0.50; // [deg]
+    double GM = 0.05; // [m]
+};
+
+// Outcome of one loading condition
+struct RegressionResult {
+    std::string condition;
+    ShipResults computed;
+    FloatingCondition book;
+    // Same condition evaluated with single precision tables, to bound the error of that mode against the double path
+    ShipResults single;
+    // Book parsing and first evaluation [ms], and mean of the repeated evaluations in double and single precision [us]
+    double totalTime, evaluateTime, singleEvaluateTime;
+    // False if the condition could not be computed, has no book values or deviates from the book beyond the tolerances
+    bool passed;
+    // True if the book holds no Floating Condition values to compare against; such a condition does not pass
+    bool unchecked;
+};
+
+// Runs every loading condition of the trim and stability book and compares the computed draughts, trim, heel and GM
+// with the "Floating Condition" block printed for it, recording the time taken by each condition alongside the error
+class RegressionHarness {
+public:
+    static const int conditionCount = 31;
+
+    RegressionHarness(const std::string& trimStabilityBook, const std::string& soundingTables, const std::string& hydrostaticTables,
+        const RegressionTolerances& tolerances = RegressionTolerances());
+
+    const std::vector<RegressionResult>& run();
+
+    // One CSV row per condition: timings, then computed value, book value and error of each quantity,
+    // then the deviation of each quantity in single precision from the double path
+    void writeReport(const std::string& fileName) const;
+
+    // Summary of the run, including the largest error of each quantity and its largest single precision deviation
+    void printSummary(std::ostream& output) const;
+
+    size_t getFailureCount() const;
+
+private:
+    std::string trimStabilityBook, soundingTables, hydrostaticTables;
+    RegressionTolerances tolerances;
+    std::vector<RegressionResult> results;
+    double modelLoadTime;
+
+    // Evaluations repeated per condition, to time the evaluation apart from the book parsing
+    static const int evaluationRepeats = 100;
+
+    bool withinTolerances(const ShipResults& computed, const FloatingCondition& book) const;
+};
+
+#endif // REGRESSIONHARNESS_H
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "ResultCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    const char cacheMagic[8] = { 'L', 'D', 'R', 'C', 'A', 'C', 'H', 'E' };
+
+    void appendInteger(std::string& key, int64_t value) {
+        key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    int64_t quantize(double value, double quantum) {
+        return static_cast<int64_t>(std::floor(value / quantum + 0.5));
+    }
+
+    template <class T>
+    void writeValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <class T>
+    bool readValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+}
+
+// Implementing the constructor
+ResultCache::ResultCache(size_t capacity, const CacheQuanta& quanta)
+    : capacity(std::max<size_t>(capacity, 1)), quanta(quanta), hits(0), misses(0), evictions(0) {
+    if (!(quanta.fill > 0.0 && quanta.density > 0.0 && quanta.value > 0.0)) {
+        throw std::invalid_argument("Cache quanta must be positive.");
+    }
+}
+
+// Implementing the evaluate method
+ShipResults ResultCache::evaluate(std::shared_ptr<const ShipModel> model, const ConditionDefinition& definition, Precision precision) {
+    const std::string key = makeKey(definition, precision);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            ++hits;
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+        ++misses;
+    }
+
+    Ship ship(model, definition);
+    ship.setPrecision(precision);
+    ShipResults results = ship.getResults();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    store(key, results);
+    return results;
+}
+
+// Implementing the find method
+bool ResultCache::find(const ConditionDefinition& definition, Precision precision, ShipResults& results) {
+    const std::string key = makeKey(definition, precision);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++misses;
+        return false;
+    }
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    results = it->second->second;
+    return true;
+}
+
+// Implementing the insert method
+void ResultCache::insert(const ConditionDefinition& definition, Precision precision, const ShipResults& results) {
+    const std::string key = makeKey(definition, precision);
+    std::lock_guard<std::mutex> lock(mutex);
+    store(key, results);
+}
+
+// Implementing the getStatistics method
+CacheStatistics ResultCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return { hits, misses, evictions, entries.size() };
+}
+
+// Implementing the clear method
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+// Implementing the save method
+void ResultCache::save(const std::string& fileName, const ShipModel& model) const {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for writing.");
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    file.write(cacheMagic, sizeof(cacheMagic));
+    const uint32_t version = fileVersion;
+    writeValue(file, version);
+    writeValue(file, model.getFingerprint());
+    writeValue(file, quanta.fill);
+    writeValue(file, quanta.density);
+    writeValue(file, quanta.value);
+    writeValue(file, static_cast<uint64_t>(entries.size()));
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        writeValue(file, static_cast<uint64_t>(it->first.size()));
+        file.write(it->first.data(), static_cast<std::streamsize>(it->first.size()));
+        writeValue(file, it->second);
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write " + fileName);
+    }
+}
+
+// Implementing the load method
+bool ResultCache::load(const std::string& fileName, const ShipModel& model) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    char magic[sizeof(cacheMagic)];
+    uint32_t version;
+    uint64_t fingerprint, count;
+    CacheQuanta fileQuanta;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0
+        || !readValue(file, version) || version != fileVersion || !readValue(file, fingerprint) || fingerprint != model.getFingerprint()
+        || !readValue(file, fileQuanta.fill) || !readValue(file, fileQuanta.density) || !readValue(file, fileQuanta.value)
+        || fileQuanta.fill != quanta.fill || fileQuanta.density != quanta.density || fileQuanta.value != quanta.value
+        || !readValue(file, count)) {
+        return false;
+    }
+
+    // The entries are read in full before any is stored, so that a truncated file leaves the cache untouched
+    std::vector<std::pair<std::string, ShipResults>> loaded;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t keyLength;
+        if (!readValue(file, keyLength) || keyLength > (1u << 20)) {
+            return false;
+        }
+        std::string key(static_cast<size_t>(keyLength), '\0');
+        ShipResults results;
+        if (!file.read(&key[0], static_cast<std::streamsize>(keyLength)) || !readValue(file, results)) {
+            return false;
+        }
+        loaded.push_back(std::make_pair(std::move(key), results));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : loaded) {
+        store(entry.first, entry.second);
+    }
+    return true;
+}
+
+// Implementing the makeKey method
+std::string ResultCache::makeKey(const ConditionDefinition& definition, Precision precision) const {
+    std::vector<const std::pair<const std::string, std::vector<double>>*> compartments;
+    compartments.reserve(definition.tankPlan.size());
+    for (const auto& pair : definition.tankPlan) {
+        if (pair.first != "Floating Condition") {
+            compartments.push_back(&pair);
+        }
+    }
+    std::sort(compartments.begin(), compartments.end(), [](const std::pair<const std::string, std::vector<double>>* a,
+        const std::pair<const std::string, std::vector<double>>* b) { return a->first < b->first; });
+
+    std::string key;
+    key.reserve(16 + 8 * definition.densities.size() + 72 * compartments.size());
+    key.push_back(precision == Precision::Single ? 'S' : 'D');
+    appendInteger(key, static_cast<int64_t>(definition.densities.size()));
+    for (double density : definition.densities) {
+        appendInteger(key, quantize(density, quanta.density));
+    }
+    for (const auto* compartment : compartments) {
+        key.append(compartment->first);
+        key.push_back('\0');
+        const std::vector<double>& values = compartment->second;
+        // The second value of a compartment is its fill percentage, except for the lightweight
+        const bool hasFill = compartment->first != "Lightweight";
+        appendInteger(key, static_cast<int64_t>(values.size()));
+        for (size_t i = 0; i < values.size(); ++i) {
+            appendInteger(key, quantize(values[i], (hasFill && i == 1) ? quanta.fill : quanta.value));
+        }
+    }
+    return key;
+}
+
+// Implementing the store method
+// The caller holds the lock
+void ResultCache::store(const std::string& key, const ShipResults& results) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = results;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    entries.emplace_front(key, results);
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+        ++evictions;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "Ship.h"
+#include "ShipModel.h"
+#include "ConditionFileReader.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <cstdint>
+#include <stdexcept>
+
+// Steps to which the inputs of a condition are rounded before they are compared
+struct CacheQuanta {
+    double fill = 0.01; // Fill percentages [%]
+    double density = 1e-4; // [t/m3]
+    double value = 1e-3; // Masses [t], centroids [m] and free surface moments [t*m] of the lightweight and deadweight items
+};
+
+struct CacheStatistics {
+    size_t hits, misses, evictions, entries;
+};
+
+// Memoizes the equilibrium of loading conditions, so that repeated and near-identical queries, e.g. the undo and redo of a planner,
+// return without interpolating any table
+// Conditions are keyed by their compartment fills, densities, lightweight and deadweight items, rounded to the quanta;
+// the least recently used entry is evicted once the capacity is reached
+// The cache may be shared between threads; conditions missing from it are evaluated outside of its lock
+class ResultCache {
+public:
+    ResultCache(size_t capacity = 4096, const CacheQuanta& quanta = CacheQuanta());
+
+    // Cached equilibrium of the condition, or that of a Ship built with the model on a miss
+    ShipResults evaluate(std::shared_ptr<const ShipModel> model, const ConditionDefinition& definition, Precision precision = Precision::Double);
+
+    // Looks the condition up without evaluating it; a hit makes it the most recently used entry
+    bool find(const ConditionDefinition& definition, Precision precision, ShipResults& results);
+
+    void insert(const ConditionDefinition& definition, Precision precision, const ShipResults& results);
+
+    CacheStatistics getStatistics() const;
+
+    void clear();
+
+    // Writes the entries, least recently used first, with the fingerprint of the model they were computed with
+    void save(const std::string& fileName, const ShipModel& model) const;
+
+    // Adds the entries of a file written by save; returns false, leaving the cache untouched, if the file does not exist
+    // or was written for another model, other quanta or another layout
+    bool load(const std::string& fileName, const ShipModel& model);
+
+private:
+    static const uint32_t fileVersion = 1;
+
+    typedef std::list<std::pair<std::string, ShipResults>> EntryList;
+
+    size_t capacity;
+    CacheQuanta quanta;
+    mutable std::mutex mutex;
+    // Most recently used entry first
+    EntryList entries;
+    std::unordered_map<std::string, EntryList::iterator> index;
+    size_t hits, misses, evictions;
+
+    // Canonical form of the rounded inputs: compartments in key order, each with its rounded values
+    std::string makeKey(const ConditionDefinition& definition, Precision precision) const;
+
+    void store(const std::string& key, const ShipResults& results);
+};
+
+#endif // RESULTCACHE_H
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "ResultWriter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+
+const char* const ResultWriter::fieldNames[ResultWriter::fieldCount] = {
+    "displacement", "lcg", "tcg", "vcg", "draught_moulded", "lcf", "lcb", "vcb", "kmt", "mct", "trim", "gm", "heel", "tf", "ta"
+};
+
+// Values of a ShipResults record, in the order of fieldNames
+static void flatten(const ShipResults& results, double (&values)[15]) {
+    double flat[15] = {
+        results.displacement, results.LCG, results.TCG, results.VCG, results.draughtMoulded, results.LCF, results.LCB,
+        results.VCB, results.KMT, results.MCT, results.trim, results.GM, results.heel, results.TF, results.TA
+    };
+    std::copy(std::begin(flat), std::end(flat), std::begin(values));
+}
+
+// Implementing the constructor
+ResultWriter::ResultWriter(const std::string& fileName, bool includeCompartments, bool binary)
+    : includeCompartments(includeCompartments), emptyFile(true) {
+    // Results are appended, so that many runs can share a single stream
+    std::ios::openmode mode = std::ios::out | std::ios::app;
+    if (binary) {
+        mode |= std::ios::binary;
+    }
+    outFile.open(fileName, mode);
+    if (!outFile.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for writing.");
+    }
+    outFile.seekp(0, std::ios::end);
+    emptyFile = (outFile.tellp() <= 0);
+    buffer.reserve(bufferCapacity);
+}
+
+// Implementing the destructor
+ResultWriter::~ResultWriter() {
+    try {
+        flush();
+    }
+    catch (const std::exception&) {
+        // Destructors must not throw; the stream state is lost at this point anyway
+    }
+}
+
+// Implementing the create method
+std::unique_ptr<ResultWriter> ResultWriter::create(const std::string& format, const std::string& fileName, bool includeCompartments) {
+    if (format == "csv") {
+        return std::unique_ptr<ResultWriter>(new CsvResultWriter(fileName, includeCompartments));
+    }
+    else if (format == "jsonl") {
+        return std::unique_ptr<ResultWriter>(new JsonLinesResultWriter(fileName, includeCompartments));
+    }
+    else if (format == "bin") {
+        return std::unique_ptr<ResultWriter>(new BinaryResultWriter(fileName, includeCompartments));
+    }
+    throw std::invalid_argument("Unknown result format: " + format);
+}
+
+// Implementing the write method
+void ResultWriter::write(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) {
+    writeRecord(label, results, compartments);
+    if (buffer.size() >= bufferCapacity) {
+        flush();
+    }
+}
+
+// Implementing the flush method
+void ResultWriter::flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    outFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    outFile.flush();
+    if (!outFile) {
+        throw std::runtime_error("Failed to write results.");
+    }
+    buffer.clear();
+}
+
+// Implementing the start method
+// Called by the derived constructors, once the virtual writeHeader is available
+void ResultWriter::start() {
+    if (emptyFile) {
+        writeHeader();
+    }
+}
+
+// Implementing the appendNumber method
+void ResultWriter::appendNumber(double value) {
+    // 17 significant digits guarantee an exact round trip of the double
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%.17g", value);
+    buffer.append(text, static_cast<size_t>(length));
+}
+
+// Implementing the appendRaw method
+void ResultWriter::appendRaw(const void* data, size_t size) {
+    buffer.append(static_cast<const char*>(data), size);
+}
+
+// Implementing the CsvResultWriter constructor
+CsvResultWriter::CsvResultWriter(const std::string& fileName, bool includeCompartments)
+    : ResultWriter(fileName, includeCompartments, false) {
+    start();
+}
+
+// Implementing the CsvResultWriter writeHeader method
+// Ship rows fill every column but "compartment" and "fsm"
+// Compartment rows fill "compartment" and the mass, centroid and FSM columns only
+void CsvResultWriter::writeHeader() {
+    buffer += "kind,label,compartment,";
+    for (size_t i = 0; i < fieldCount; ++i) {
+        buffer += fieldNames[i];
+        buffer += (i == 3) ? ",fsm," : ",";
+    }
+    buffer.back() = '\n';
+}
+
+// Implementing the CsvResultWriter writeRecord method
+void CsvResultWriter::writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) {
+    double values[fieldCount];
+    flatten(results, values);
+
+    buffer += "ship,";
+    appendField(label);
+    buffer += ",,";
+    for (size_t i = 0; i < fieldCount; ++i) {
+        appendNumber(values[i]);
+        buffer += (i == 3) ? ",," : ",";
+    }
+    buffer.back() = '\n';
+
+    if (includeCompartments) {
+        for (const auto& entry : compartments) {
+            double mass, lcg, tcg, vcg, fsm;
+            std::tie(mass, lcg, tcg, vcg, fsm) = entry.second;
+            buffer += "compartment,";
+            appendField(label);
+            buffer += ',';
+            appendField(entry.first);
+            for (double value : { mass, lcg, tcg, vcg, fsm }) {
+                buffer += ',';
+                appendNumber(value);
+            }
+            // Hydrostatic columns are left empty
+            buffer.append(fieldCount - 4, ',');
+            buffer += '\n';
+        }
+    }
+}
+
+// Implementing the CsvResultWriter appendField method
+void CsvResultWriter::appendField(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        buffer += text;
+        return;
+    }
+    buffer += '"';
+    for (char c : text) {
+        if (c == '"') {
+            buffer += '"';
+        }
+        buffer += c;
+    }
+    buffer += '"';
+}
+
+// Implementing the JsonLinesResultWriter constructor
+JsonLinesResultWriter::JsonLinesResultWriter(const std::string& fileName, bool includeCompartments)
+    : ResultWriter(fileName, includeCompartments, false) {
+    start();
+}
+
+// Implementing the JsonLinesResultWriter writeHeader method
+void JsonLinesResultWriter::writeHeader() {
+    buffer += "{\"schema\":\"loadicator-results\",\"version\":1,\"fields\":[";
+    for (size_t i = 0; i < fieldCount; ++i) {
+        buffer += '"';
+        buffer += fieldNames[i];
+        buffer += (i + 1 < fieldCount) ? "\"," : "\"";
+    }
+    buffer += "],\"compartment_fields\":[\"mass\",\"lcg\",\"tcg\",\"vcg\",\"fsm\"]}\n";
+}
+
+// Implementing the JsonLinesResultWriter writeRecord method
+void JsonLinesResultWriter::writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) {
+    double values[fieldCount];
+    flatten(results, values);
+
+    buffer += "{\"label\":";
+    appendString(label);
+    for (size_t i = 0; i < fieldCount; ++i) {
+        buffer += ",\"";
+        buffer += fieldNames[i];
+        buffer += "\":";
+        appendValue(values[i]);
+    }
+
+    if (includeCompartments) {
+        buffer += ",\"compartments\":{";
+        bool first = true;
+        for (const auto& entry : compartments) {
+            double mass, lcg, tcg, vcg, fsm;
+            std::tie(mass, lcg, tcg, vcg, fsm) = entry.second;
+            if (!first) {
+                buffer += ',';
+            }
+            appendString(entry.first);
+            buffer += ":[";
+            appendValue(mass);
+            for (double value : { lcg, tcg, vcg, fsm }) {
+                buffer += ',';
+                appendValue(value);
+            }
+            buffer += ']';
+            first = false;
+        }
+        buffer += '}';
+    }
+    buffer += "}\n";
+}
+
+// Implementing the JsonLinesResultWriter appendString method
+void JsonLinesResultWriter::appendString(const std::string& text) {
+    buffer += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            buffer += '\\';
+            buffer += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+            buffer += escaped;
+        }
+        else {
+            buffer += c;
+        }
+    }
+    buffer += '"';
+}
+
+// Implementing the JsonLinesResultWriter appendValue method
+void JsonLinesResultWriter::appendValue(double value) {
+    if (std::isfinite(value)) {
+        appendNumber(value);
+    }
+    else {
+        buffer += "null";
+    }
+}
+
+// Implementing the BinaryResultWriter constructor
+BinaryResultWriter::BinaryResultWriter(const std::string& fileName, bool includeCompartments)
+    : ResultWriter(fileName, includeCompartments, true) {
+    start();
+}
+
+// Implementing the BinaryResultWriter writeHeader method
+// Layout: "LDRS", uint32 version, uint32 field count, then each field name as uint8 length and bytes
+// All integers and doubles are stored in the native byte order of the writing machine
+void BinaryResultWriter::writeHeader() {
+    const uint32_t version = 1;
+    const uint32_t count = static_cast<uint32_t>(fieldCount);
+    appendRaw("LDRS", 4);
+    appendRaw(&version, sizeof(version));
+    appendRaw(&count, sizeof(count));
+    for (size_t i = 0; i < fieldCount; ++i) {
+        const uint8_t length = static_cast<uint8_t>(std::char_traits<char>::length(fieldNames[i]));
+        appendRaw(&length, sizeof(length));
+        appendRaw(fieldNames[i], length);
+    }
+}
+
+// Implementing the BinaryResultWriter writeRecord method
+// Layout: uint16 label length, label, fieldCount doubles, uint32 compartment count,
+// then per compartment uint8 key length, key and 5 doubles (mass, LCG, TCG, VCG, FSM)
+void BinaryResultWriter::writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) {
+    double values[fieldCount];
+    flatten(results, values);
+
+    const uint16_t labelLength = static_cast<uint16_t>(label.size());
+    appendRaw(&labelLength, sizeof(labelLength));
+    appendRaw(label.data(), labelLength);
+    appendRaw(values, sizeof(values));
+
+    const uint32_t compartmentCount = includeCompartments ? static_cast<uint32_t>(compartments.size()) : 0;
+    appendRaw(&compartmentCount, sizeof(compartmentCount));
+    if (includeCompartments) {
+        for (const auto& entry : compartments) {
+            double properties[5];
+            std::tie(properties[0], properties[1], properties[2], properties[3], properties[4]) = entry.second;
+            const uint8_t keyLength = static_cast<uint8_t>(entry.first.size());
+            appendRaw(&keyLength, sizeof(keyLength));
+            appendRaw(entry.first.data(), keyLength);
+            appendRaw(properties, sizeof(properties));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include <string>
+#include <unordered_map>
+#include <tuple>
+#include <memory>
+#include <fstream>
+#include <stdexcept>
+
+// Final equilibrium of the ship for one loading condition (or one step of a sequence)
+struct ShipResults {
+    double displacement, LCG, TCG, VCG;
+    double draughtMoulded, LCF, LCB, VCB, KMT, MCT, trim, GM, heel, TF, TA;
+};
+
+// Mass, LCG, TCG, VCG and FSM of every compartment, as produced by LoadingCondition
+typedef std::unordered_map<std::string, std::tuple<double, double, double, double, double>> CompartmentProperties;
+
+// Result sink appending many conditions or steps to a single buffered stream
+// A schema header is written once, when the stream is created or found empty
+class ResultWriter {
+public:
+    ResultWriter(const std::string& fileName, bool includeCompartments, bool binary);
+    virtual ~ResultWriter();
+
+    // Factory for the supported formats: "csv", "jsonl" and "bin"
+    static std::unique_ptr<ResultWriter> create(const std::string& format, const std::string& fileName, bool includeCompartments);
+
+    void write(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments);
+
+    void flush();
+
+protected:
+    std::string buffer;
+    bool includeCompartments;
+
+    // Number of ship level fields, and their names in the order they are written
+    static const size_t fieldCount = 15;
+    static const char* const fieldNames[fieldCount];
+
+    void start();
+    void appendNumber(double value);
+    void appendRaw(const void* data, size_t size);
+
+    virtual void writeHeader() = 0;
+    virtual void writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) = 0;
+
+private:
+    std::ofstream outFile;
+    bool emptyFile;
+
+    // Buffered bytes are handed to the stream once this size is exceeded
+    static const size_t bufferCapacity = 1 << 20;
+};
+
+// One row per condition, plus one row per compartment when requested
+class CsvResultWriter : public ResultWriter {
+public:
+    CsvResultWriter(const std::string& fileName, bool includeCompartments);
+
+private:
+    void writeHeader() override;
+    void writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) override;
+
+    // Text field, quoted with doubled quotes when it holds a comma, a quote or a line break (RFC 4180)
+    void appendField(const std::string& text);
+};
+
+// One JSON object per line, preceded by a schema object
+class JsonLinesResultWriter : public ResultWriter {
+public:
+    JsonLinesResultWriter(const std::string& fileName, bool includeCompartments);
+
+private:
+    void writeHeader() override;
+    void writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) override;
+
+    // Quoted string, with quotes, backslashes and control characters escaped
+    void appendString(const std::string& text);
+    // JSON has no NaN or infinity, so non-finite values are written as null
+    void appendValue(double value);
+};
+
+// Length-prefixed records of native doubles, preceded by a schema header
+class BinaryResultWriter : public ResultWriter {
+public:
+    BinaryResultWriter(const std::string& fileName, bool includeCompartments);
+
+private:
+    void writeHeader() override;
+    void writeRecord(const std::string& label, const ShipResults& results, const CompartmentProperties& compartments) override;
+};
+
+#endif // RESULTWRITER_H
\ No newline at end of file
@@ -2,59 +2,138 @@
 
 // Implementing the constructor
 Ship::Ship(const std::string& trimStabilityBook, const std::string& soundingTables, const std::string& userInput, const std::string& hydrostaticTables)
-    : loadCond(trimStabilityBook, soundingTables, userInput), hydroReader(hydrostaticTables, 0.0), userInput(userInput) {
-    loadCond.calculate();
-    tankProperties = loadCond.getData();
+    : Ship(ShipModel::loadAsync(soundingTables, hydrostaticTables).share(), trimStabilityBook, userInput) {
+}
+
+// Implementing the constructor for a loaded model
+Ship::Ship(std::shared_ptr<const ShipModel> model, const std::string& trimStabilityBook, const std::string& userInput)
+    : loadCond(trimStabilityBook, userInput), model(model), userInput(userInput), grainCargo(false) {
+    evaluate();
+}
+
+// Implementing the constructor for a model being loaded
+// The join point: the book has been parsed by the time the model is awaited
+Ship::Ship(std::shared_future<std::shared_ptr<const ShipModel>> modelFuture, const std::string& trimStabilityBook, const std::string& userInput)
+    : loadCond(trimStabilityBook, userInput), model(modelFuture.get()), userInput(userInput), grainCargo(false) {
+    evaluate();
+}
+
+// Implementing the constructor for a condition file
+Ship::Ship(std::shared_ptr<const ShipModel> model, const ConditionDefinition& definition)
+    : loadCond(definition), model(model), userInput(definition.label), grainCargo(false) {
+    LoadingCondition::checkFills(*this->model, definition);
+    evaluate();
+}
+
+// Implementing the constructor for a condition file and a model being loaded
+Ship::Ship(std::shared_future<std::shared_ptr<const ShipModel>> modelFuture, const ConditionDefinition& definition)
+    : loadCond(definition), model(modelFuture.get()), userInput(definition.label), grainCargo(false) {
+    LoadingCondition::checkFills(*model, definition);
+    evaluate();
+}
+
+// Implementing the evaluate method
+void Ship::evaluate() {
+    loadCond.calculate(*model);
+    sumMoments();
+    updateEquilibrium();
+}
+
+// Implementing the updateSounding method
+void Ship::updateSounding(const std::string& key, double sounding) {
+    auto it = loadCond.getData().find(key);
+    if (it == loadCond.getData().end()) {
+        throw std::runtime_error("Compartment not in the loading condition: " + key);
+    }
+    double oldMass, oldLcg, oldTcg, oldVcg, oldFsm;
+    std::tie(oldMass, oldLcg, oldTcg, oldVcg, oldFsm) = it->second;
 
+    // The "Tr=" columns of the sounding tables are negative by the stern, opposite to the trim computed below
+    double mass, lcg, tcg, vcg, fsm;
+    std::tie(mass, lcg, tcg, vcg, fsm) = loadCond.updateSounding(*model, key, sounding, -trim);
+
+    if (++updatesSinceSummation >= resummationInterval) {
+        sumMoments();
+    }
+    else {
+        displacement += mass - oldMass;
+        longitudinalMoment += mass * lcg - oldMass * oldLcg;
+        transverseMoment += mass * tcg + fsm - oldMass * oldTcg - oldFsm;
+        verticalMoment += mass * vcg - oldMass * oldVcg;
+    }
+    updateEquilibrium();
+}
+
+// Implementing the sumMoments method
+void Ship::sumMoments() {
     displacement = 0.0;
     longitudinalMoment = 0.0;
     transverseMoment = 0.0;
     verticalMoment = 0.0;
-    LCG = 0.0;
-    TCG = 0.0;
-    VCG = 0.0;
-    draughtMoulded = 0.0;
-    LCF = 0.0;
-    LCB = 0.0;
-    VCB = 0.0;
-    KMT = 0.0;
-    MCT = 0.0;
-    trim = 0.0;
-    GM = 0.0;
-    heel = 0.0;
-    TF = 0.0;
-    TA = 0.0;
+    updatesSinceSummation = 0;
 
     // Compute displacement after loading condition processing
-    for (const auto& entry : tankProperties) {
+    for (const auto& entry : loadCond.getData()) {
         double mass, lcg, tcg, vcg, fsm;
         std::tie(mass, lcg, tcg, vcg, fsm) = entry.second;
+        if (!grainCargo && entry.first.compare(0, 3, "R1.") == 0) {
+            fsm = 0.0;
+        }
         displacement += mass;
         longitudinalMoment += mass * lcg;
         transverseMoment += mass * tcg + fsm;
         verticalMoment += mass * vcg;
     }
+}
+
+// Implementing the updateEquilibrium method
+void Ship::updateEquilibrium() {
+    ShipResults results = solveEquilibrium(*model, displacement, longitudinalMoment, transverseMoment, verticalMoment, loadCond.getPrecision());
+    LCG = results.LCG;
+    TCG = results.TCG;
+    VCG = results.VCG;
+    draughtMoulded = results.draughtMoulded;
+    LCF = results.LCF;
+    LCB = results.LCB;
+    VCB = results.VCB;
+    KMT = results.KMT;
+    MCT = results.MCT;
+    trim = results.trim;
+    GM = results.GM;
+    heel = results.heel;
+    TF = results.TF;
+    TA = results.TA;
+}
+
+// Implementing the solveEquilibrium method
+ShipResults Ship::solveEquilibrium(const ShipModel& model, double displacement, double longitudinalMoment, double transverseMoment, double verticalMoment,
+    Precision precision) {
+    ShipResults results;
+    results.displacement = displacement;
+    results.LCG = 0.0;
+    results.TCG = 0.0;
+    results.VCG = 0.0;
 
     // Compute COG (if displacement is not zero)
     if (displacement != 0) {
-        LCG = longitudinalMoment / displacement;
-        TCG = transverseMoment / displacement;
-        VCG = verticalMoment / displacement;
+        results.LCG = longitudinalMoment / displacement;
+        results.TCG = transverseMoment / displacement;
+        results.VCG = verticalMoment / displacement;
     }
     else {
         std::cerr << "Calculated displacement is equal to zero." << std::endl;
     }
 
-    // Initialize hydroReader with computed displacement
-    hydroReader = HydrostaticsReader(hydrostaticTables, displacement);
-    std::tie(draughtMoulded, LCF, LCB, VCB, KMT, MCT) = hydroReader.interpolate();
+    // Interpolate the hydrostatic tables, read once per model, at the computed displacement
+    std::tie(results.draughtMoulded, results.LCF, results.LCB, results.VCB, results.KMT, results.MCT) = model.interpolateHydrostatics(displacement, precision);
 
     // Utilize known equations to calculate ship equilibrium
-    trim = displacement * (LCB - LCG) / (100 * MCT);
-    GM = KMT - VCG;
-    heel = std::atan(TCG / GM) * 180 / M_PI;
-    TF = draughtMoulded - 0.5 * trim;
-    TA = draughtMoulded + 0.5 * trim;
+    results.trim = displacement * (results.LCB - results.LCG) / (100 * results.MCT);
+    results.GM = results.KMT - results.VCG;
+    results.heel = std::atan(results.TCG / results.GM) * 180 / M_PI;
+    results.TF = results.draughtMoulded - 0.5 * results.trim;
+    results.TA = results.draughtMoulded + 0.5 * results.trim;
+    return results;
 }
 
 // Implementing the printResultsToFile method
@@ -69,25 +148,134 @@ void Ship::printResultsToFile(const std::string& fileName) const {
 
     std::ostream& output = outFile;
 
-    output << "Loading Condition: " << userInput << std::endl;
-    output << "Total weight: " << displacement << " [tons]" << std::endl;
-    output << "LCG: " << LCG << " [m from AP]" << std::endl;
-    output << "TCG: " << TCG << " [m]" << std::endl;
-    output << "VCG: " << VCG << " [m]" << std::endl;
-    output << "Draught moulded: " << draughtMoulded << " [m]" << std::endl;
-    output << "LCF: " << LCF << " [m from AP]" << std::endl;
-    output << "LCB: " << LCB << " [m from AP]" << std::endl;
-    output << "VCB: " << VCB << " [m]" << std::endl;
-    output << "KMT: " << KMT << " [m]" << std::endl;
-    output << "MCT: " << MCT << " [tons/cm]" << std::endl;
-    output << "Trim: " << trim << " [m]" << std::endl;
-    output << "GM: " << GM << " [m]" << std::endl;
-    output << "Heel: " << heel << " [deg]" << std::endl;
-    output << "TF: " << TF << " [m]" << std::endl;
-    output << "TA: " << TA << " [m]" << std::endl;
+    output << "Loading Condition: " << userInput << '\n';
+    output << "Total weight: " << displacement << " [tons]" << '\n';
+    output << "LCG: " << LCG << " [m from AP]" << '\n';
+    output << "TCG: " << TCG << " [m]" << '\n';
+    output << "VCG: " << VCG << " [m]" << '\n';
+    output << "Draught moulded: " << draughtMoulded << " [m]" << '\n';
+    output << "LCF: " << LCF << " [m from AP]" << '\n';
+    output << "LCB: " << LCB << " [m from AP]" << '\n';
+    output << "VCB: " << VCB << " [m]" << '\n';
+    output << "KMT: " << KMT << " [m]" << '\n';
+    output << "MCT: " << MCT << " [tons/cm]" << '\n';
+    output << "Trim: " << trim << " [m]" << '\n';
+    output << "GM: " << GM << " [m]" << '\n';
+    output << "Heel: " << heel << " [deg]" << '\n';
+    output << "TF: " << TF << " [m]" << '\n';
+    output << "TA: " << TA << " [m]" << '\n';
 
     outFile.close();
 
     // Inform user about successful file creation
     std::cout << "Results have been written to " << fileName << std::endl;
+}
+
+// Implementing the writeResults method
+void Ship::writeResults(ResultWriter& writer) const {
+    writeResults(writer, userInput);
+}
+
+// Implementing the writeResults method with a label
+void Ship::writeResults(ResultWriter& writer, const std::string& label) const {
+    writer.write(label, getResults(), loadCond.getData());
+}
+
+// Implementing the getResults method
+ShipResults Ship::getResults() const {
+    ShipResults results;
+    results.displacement = displacement;
+    results.LCG = LCG;
+    results.TCG = TCG;
+    results.VCG = VCG;
+    results.draughtMoulded = draughtMoulded;
+    results.LCF = LCF;
+    results.LCB = LCB;
+    results.VCB = VCB;
+    results.KMT = KMT;
+    results.MCT = MCT;
+    results.trim = trim;
+    results.GM = GM;
+    results.heel = heel;
+    results.TF = TF;
+    results.TA = TA;
+    return results;
+}
+
+// Implementing the getBookCondition method
+const FloatingCondition& Ship::getBookCondition() const {
+    return loadCond.getFloatingCondition();
+}
+
+// Implementing the getModel method
+const ShipModel& Ship::getModel() const {
+    return *model;
+}
+
+// Implementing the getCompartments method
+const CompartmentProperties& Ship::getCompartments() const {
+    return loadCond.getData();
+}
+
+// Implementing the getLoadingCondition method
+const LoadingCondition& Ship::getLoadingCondition() const {
+    return loadCond;
+}
+
+// Implementing the checkGrain method
+// The metacentric height is corrected for the free surfaces of the tanks, while the holds are accounted for by the grain heeling moments
+GrainResults Ship::checkGrain(const GrainStability& grain) const {
+    double volumes[GrainStability::holdCount] = {};
+    double holdMasses[GrainStability::holdCount] = {};
+    double tankMoments = 0.0;
+    bool loaded = false;
+    for (const auto& entry : loadCond.getData()) {
+        const std::string& key = entry.first;
+        if (key.size() >= 4 && key.compare(0, 3, "R1.") == 0 && isdigit(key[3])) {
+            const size_t holdNumber = static_cast<size_t>(key[3] - '0');
+            if (holdNumber >= 1 && holdNumber <= GrainStability::holdCount) {
+                holdMasses[holdNumber - 1] = std::get<0>(entry.second);
+                loaded = loaded || holdMasses[holdNumber - 1] > 0.0;
+            }
+        }
+        else {
+            tankMoments += std::get<4>(entry.second);
+        }
+    }
+    const double correctedGM = GM - tankMoments / displacement;
+
+    // Without cargo in any hold there is no grain to shift, and the density of the holds may not even be given
+    if (!loaded) {
+        return grain.check(volumes, 1.0, displacement, correctedGM);
+    }
+    const double density = loadCond.getDensity("R1.1");
+    if (!(density > 0.0)) {
+        throw std::runtime_error("The density of the cargo holds must be positive to check grain stability.");
+    }
+    for (size_t h = 0; h < GrainStability::holdCount; ++h) {
+        volumes[h] = holdMasses[h] / density;
+    }
+    return grain.check(volumes, 1.0 / density, displacement, correctedGM);
+}
+
+// Implementing the setGrainCargo method
+void Ship::setGrainCargo(bool grainCargo) {
+    if (this->grainCargo != grainCargo) {
+        this->grainCargo = grainCargo;
+        sumMoments();
+        updateEquilibrium();
+    }
+}
+
+// Implementing the setPrecision method
+void Ship::setPrecision(Precision precision) {
+    if (loadCond.getPrecision() != precision) {
+        loadCond.setPrecision(precision);
+        evaluate();
+    }
+}
+
+// Implementing the getMoments method
+std::tuple<double, double, double, double> Ship::getMoments() const {
+    return std::make_tuple(displacement, longitudinalMoment, transverseMoment, verticalMoment);
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 #define SHIP_H
 
 #include "LoadingCondition.h"
-#include "HydrostaticsReader.h"
+#include "ShipModel.h"
+#include "ResultWriter.h"
+#include "GrainStability.h"
+#include <memory>
+#include <future>
 #include <string>
 #include <unordered_map>
 #include <tuple>
@@ -16,17 +20,81 @@ constexpr double M_PI = 3.14159265358979323846;
 
 class Ship {
 public:
+    // Loads the ship model concurrently with the parsing of the trim and stability book
     Ship(const std::string& trimStabilityBook, const std::string& soundingTables, const std::string& userInput, const std::string& hydrostaticTables);
 
+    // Reuses a model that is already loaded, e.g. across several loading conditions
+    Ship(std::shared_ptr<const ShipModel> model, const std::string& trimStabilityBook, const std::string& userInput);
+
+    // Reuses a model that may still be loading; it is awaited once the book has been parsed
+    Ship(std::shared_future<std::shared_ptr<const ShipModel>> modelFuture, const std::string& trimStabilityBook, const std::string& userInput);
+
+    // Evaluates a condition read from a condition file, without the trim and stability book
+    Ship(std::shared_ptr<const ShipModel> model, const ConditionDefinition& definition);
+
+    Ship(std::shared_future<std::shared_ptr<const ShipModel>> modelFuture, const ConditionDefinition& definition);
+
     void printResultsToFile(const std::string& fileName = "Results.txt") const;
 
+    void writeResults(ResultWriter& writer) const;
+
+    // Same as above, with a record label other than the loading condition, e.g. the timestamp of a gauge reading
+    void writeResults(ResultWriter& writer, const std::string& label) const;
+
+    ShipResults getResults() const;
+
+    // Equilibrium printed by the trim and stability book for the same condition
+    const FloatingCondition& getBookCondition() const;
+
+    const ShipModel& getModel() const;
+
+    // Grain heeling moments of the cargo holds and the criteria of the International Grain Code, at the current equilibrium
+    GrainResults checkGrain(const GrainStability& grain) const;
+
+    // With grain cargo, the free surface moments of the holds add to the heeling moment, as those of the tanks do
+    // Other bulk cargoes do not shift, so the holds are left out by default
+    void setGrainCargo(bool grainCargo);
+
+    // Displacement, then the longitudinal, transverse and vertical moments summed for the equilibrium
+    std::tuple<double, double, double, double> getMoments() const;
+
+    // Mass, LCG, TCG, VCG and FSM of every compartment of the loading condition
+    const CompartmentProperties& getCompartments() const;
+
+    const LoadingCondition& getLoadingCondition() const;
+
+    // Equilibrium for the given totals, with the equations used for every loading condition
+    // As summed by the ship, the transverse moment includes the free surface moments
+    static ShipResults solveEquilibrium(const ShipModel& model, double displacement, double longitudinalMoment, double transverseMoment, double verticalMoment,
+        Precision precision = Precision::Double);
+
+    // Single precision interpolates the tables in float, e.g. for Monte Carlo runs; the sums of masses and moments remain in double precision
+    // Re-evaluates the loading condition in the new precision
+    void setPrecision(Precision precision);
+
+    // Recomputes the compartments and the equilibrium from the loading condition
+    // Once the condition has been evaluated, this performs no heap allocation
+    void evaluate();
+
+    // Re-evaluates one tank from a gauge reading (cm), then the equilibrium from the running moment totals
+    // The tank is interpolated at the current trim, i.e. the trim of the previous equilibrium
+    void updateSounding(const std::string& key, double sounding);
+
 private:
+    // Declared before model, so that the book is parsed before the model loading is awaited
     LoadingCondition loadCond;
-    std::unordered_map<std::string, std::tuple<double, double, double, double, double>> tankProperties;
-    HydrostaticsReader hydroReader;
+    std::shared_ptr<const ShipModel> model;
     std::string userInput;
+    bool grainCargo;
     double displacement, longitudinalMoment, transverseMoment, verticalMoment, LCG, TCG, VCG;
     double draughtMoulded, LCF, LCB, VCB, KMT, MCT, trim, GM, heel, TF, TA;
+
+    // Running totals are summed afresh after this many updates, so that rounding errors do not accumulate
+    static const size_t resummationInterval = 4096;
+    size_t updatesSinceSummation;
+
+    void sumMoments();
+    void updateEquilibrium();
 };
 
 #endif // SHIP_H
\ No newline at end of file
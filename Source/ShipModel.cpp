@@ -0,0 +1,201 @@
+#include "ShipModel.h"
+#include <algorithm>
+
+#ifdef LOADICATOR_EMBEDDED_TABLES
+#include "EmbeddedShipTables.h"
+
+// The layout of the generated tables is checked when the binary is compiled
+static_assert(EmbeddedShipTables::holdCount == ShipModel::holdCount, "The embedded tables were generated for another number of cargo holds.");
+static_assert(EmbeddedShipTables::hydrostatics.rowCount >= 2, "The embedded hydrostatic table needs at least two rows.");
+static_assert(EmbeddedShipTables::hydrostatics.offset + EmbeddedShipTables::hydrostatics.rowCount * HydrostaticSchema::columnCount
+    <= EmbeddedShipTables::arenaLength, "The embedded hydrostatic table extends beyond the arena.");
+#endif
+
+// Implementing the constructor
+// Every input is launched before the first one is awaited, so the reads overlap
+ShipModel::ShipModel(const std::string& soundingTables, const std::string& hydrostaticTables, const std::string& cargoHoldDirectory)
+    : ShipModel(std::async(std::launch::async, [soundingTables]() { return SoundingTablesReader(soundingTables); }),
+        readCargoHolds(cargoHoldDirectory),
+        std::async(std::launch::async, [hydrostaticTables]() { return HydrostaticsReader(hydrostaticTables); })) {
+}
+
+// Implementing the joining constructor
+ShipModel::ShipModel(std::future<SoundingTablesReader> soundingFuture, std::vector<std::future<CargoHoldReader>> holdFutures,
+    std::future<HydrostaticsReader> hydroFuture)
+    : arenaData(nullptr), arenaLength(0) {
+    SoundingTablesReader soundingReader = soundingFuture.get();
+    std::vector<CargoHoldReader> holdReaders;
+    for (auto& holdFuture : holdFutures) {
+        holdReaders.push_back(holdFuture.get());
+    }
+    HydrostaticsReader hydroReader = hydroFuture.get();
+
+    // Size the arena once, so that it is a single allocation
+    size_t doubleCount = hydroReader.getData().size() * HydrostaticSchema::columnCount;
+    for (const auto& holdReader : holdReaders) {
+        doubleCount += holdReader.getData().size() * CargoHoldSchema::columnCount;
+    }
+    for (const auto& pair : soundingReader.getAllData()) {
+        doubleCount += pair.second.size() * SoundingTableSchema::columnCount;
+    }
+    arena.reserve(doubleCount);
+
+    for (const auto& pair : soundingReader.getAllData()) {
+        soundingExtents[pair.first] = append(pair.second);
+    }
+    for (int i = 0; i < holdCount; ++i) {
+        holdExtents[i] = append(holdReaders[i].getData());
+    }
+    hydrostaticExtent = append(hydroReader.getData());
+    arenaData = arena.data();
+    arenaLength = arena.size();
+}
+
+// Implementing the empty constructor
+ShipModel::ShipModel()
+    : arenaData(nullptr), arenaLength(0), holdExtents(), hydrostaticExtent() {
+}
+
+// Implementing the loadAsync method
+std::future<std::shared_ptr<const ShipModel>> ShipModel::loadAsync(const std::string& soundingTables, const std::string& hydrostaticTables,
+    const std::string& cargoHoldDirectory) {
+#ifdef LOADICATOR_EMBEDDED_TABLES
+    // The data files are not read
+    (void)soundingTables;
+    (void)hydrostaticTables;
+    (void)cargoHoldDirectory;
+    std::promise<std::shared_ptr<const ShipModel>> model;
+    model.set_value(embedded());
+    return model.get_future();
+#else
+    return std::async(std::launch::async, [soundingTables, hydrostaticTables, cargoHoldDirectory]() {
+        return std::shared_ptr<const ShipModel>(new ShipModel(soundingTables, hydrostaticTables, cargoHoldDirectory));
+        });
+#endif
+}
+
+#ifdef LOADICATOR_EMBEDDED_TABLES
+// Implementing the embedded method
+// The model is built once; it allocates the key index only, the tables being read in place
+std::shared_ptr<const ShipModel> ShipModel::embedded() {
+    static const std::shared_ptr<const ShipModel> model = []() {
+        std::shared_ptr<ShipModel> built(new ShipModel());
+        built->arenaData = EmbeddedShipTables::arena;
+        built->arenaLength = EmbeddedShipTables::arenaLength;
+        for (size_t i = 0; i < EmbeddedShipTables::holdCount; ++i) {
+            built->holdExtents[i] = { EmbeddedShipTables::holds[i].offset, EmbeddedShipTables::holds[i].rowCount };
+        }
+        built->hydrostaticExtent = { EmbeddedShipTables::hydrostatics.offset, EmbeddedShipTables::hydrostatics.rowCount };
+        built->soundingExtents.reserve(EmbeddedShipTables::soundingCount);
+        for (const EmbeddedShipTables::SoundingEntry& entry : EmbeddedShipTables::soundings) {
+            built->soundingExtents[entry.key] = { entry.extent.offset, entry.extent.rowCount };
+        }
+        return std::shared_ptr<const ShipModel>(built);
+    }();
+    return model;
+}
+#endif
+
+// Implementing the getSoundingTable method
+template <class Value>
+TableView<SoundingTableSchema, Value> ShipModel::getSoundingTable(const std::string& key) const {
+    auto it = soundingExtents.find(key);
+    if (it == soundingExtents.end()) {
+        return TableView<SoundingTableSchema, Value>();
+    }
+    return view<SoundingTableSchema, Value>(it->second);
+}
+
+// Implementing the getSoundingKeys method
+std::vector<std::string> ShipModel::getSoundingKeys() const {
+    std::vector<std::string> keys;
+    for (const auto& pair : soundingExtents) {
+        keys.push_back(pair.first);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Implementing the getCargoHold method
+template <class Value>
+TableView<CargoHoldSchema, Value> ShipModel::getCargoHold(int holdNumber) const {
+    if (holdNumber < 1 || holdNumber > holdCount) {
+        throw std::out_of_range("Non-existent cargo hold: " + std::to_string(holdNumber));
+    }
+    return view<CargoHoldSchema, Value>(holdExtents[holdNumber - 1]);
+}
+
+// Implementing the getHydrostaticTable method
+template <class Value>
+TableView<HydrostaticSchema, Value> ShipModel::getHydrostaticTable() const {
+    return view<HydrostaticSchema, Value>(hydrostaticExtent);
+}
+
+// Implementing the interpolateHydrostatics method
+std::tuple<double, double, double, double, double, double> ShipModel::interpolateHydrostatics(double displacement, Precision precision) const {
+    if (precision == Precision::Single) {
+        return HydrostaticsReader::interpolate(getHydrostaticTable<float>(), displacement);
+    }
+    return HydrostaticsReader::interpolate(getHydrostaticTable(), displacement);
+}
+
+// Implementing the getFingerprint method
+// FNV-1a over the bytes of the arena
+uint64_t ShipModel::getFingerprint() const {
+    uint64_t hash = 14695981039346656037ull;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(arenaData);
+    for (size_t i = 0; i < arenaLength * sizeof(double); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Implementing the readCargoHolds method
+std::vector<std::future<CargoHoldReader>> ShipModel::readCargoHolds(const std::string& cargoHoldDirectory) {
+    std::vector<std::future<CargoHoldReader>> holdFutures;
+    for (int holdNumber = 1; holdNumber <= holdCount; ++holdNumber) {
+        std::string fileName = cargoHoldDirectory + "/Hold (" + std::to_string(holdNumber) + ").txt";
+        holdFutures.push_back(std::async(std::launch::async, [fileName]() { return CargoHoldReader(fileName); }));
+    }
+    return holdFutures;
+}
+
+// Implementing the append method
+template <class Row>
+ShipModel::TableExtent ShipModel::append(const std::vector<Row>& rows) {
+    TableExtent extent = { arena.size(), rows.size() };
+    for (const Row& row : rows) {
+        arena.insert(arena.end(), row.begin(), row.end());
+    }
+    return extent;
+}
+
+// Implementing the arenaBase method
+template <>
+const double* ShipModel::arenaBase<double>() const {
+    return arenaData;
+}
+
+// Implementing the arenaBase method for single precision
+// The copy is made once, by whichever thread first asks for it, whether the arena is owned or mapped from a segment
+template <>
+const float* ShipModel::arenaBase<float>() const {
+    std::call_once(singleArenaFlag, [this]() {
+        singleArena.assign(arenaData, arenaData + arenaLength);
+        });
+    return singleArena.data();
+}
+
+// Implementing the view method
+template <class Schema, class Value>
+TableView<Schema, Value> ShipModel::view(const TableExtent& extent) const {
+    return TableView<Schema, Value>(arenaBase<Value>() + extent.offset, extent.rowCount);
+}
+
+// The table getters are compiled for the double tables and their single precision copy
+template TableView<SoundingTableSchema, double> ShipModel::getSoundingTable<double>(const std::string& key) const;
+template TableView<SoundingTableSchema, float> ShipModel::getSoundingTable<float>(const std::string& key) const;
+template TableView<CargoHoldSchema, double> ShipModel::getCargoHold<double>(int holdNumber) const;
+template TableView<CargoHoldSchema, float> ShipModel::getCargoHold<float>(int holdNumber) const;
+template TableView<HydrostaticSchema, double> ShipModel::getHydrostaticTable<double>() const;
+template TableView<HydrostaticSchema, float> ShipModel::getHydrostaticTable<float>() const;
\ No newline at end of file
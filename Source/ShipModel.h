@@ -0,0 +1,109 @@
+#ifndef SHIPMODEL_H
+#define SHIPMODEL_H
+
+#include "SoundingTablesReader.h"
+#include "CargoHoldReader.h"
+#include "HydrostaticsReader.h"
+#include "TableSchemas.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <tuple>
+#include <memory>
+#include <future>
+#include <stdexcept>
+#include <mutex>
+
+// Precision of the table kernels; the mass and moment sums and the equilibrium are always carried out in double precision
+enum class Precision {
+    Double,
+    Single
+};
+
+// Tables describing the ship, independent of any loading condition
+// The sounding tables, the cargo hold files and the hydrostatic tables are read concurrently,
+// then packed into a single arena; the evaluation path only ever sees read-only views into it
+class ShipModel {
+public:
+    static const int holdCount = 9;
+
+    ShipModel(const std::string& soundingTables, const std::string& hydrostaticTables, const std::string& cargoHoldDirectory = "Data/Cargo hold data");
+
+    ShipModel(const ShipModel&) = delete;
+    ShipModel& operator=(const ShipModel&) = delete;
+
+    // Starts loading the model in the background, e.g. while the trim and stability book is being parsed
+    // Built with LOADICATOR_EMBEDDED_TABLES, returns the embedded model instead, and no file is read
+    static std::future<std::shared_ptr<const ShipModel>> loadAsync(const std::string& soundingTables, const std::string& hydrostaticTables,
+        const std::string& cargoHoldDirectory = "Data/Cargo hold data");
+
+#ifdef LOADICATOR_EMBEDDED_TABLES
+    // Model compiled into the binary from the header written by ShipTableGenerator; its arena is the constant array itself
+    static std::shared_ptr<const ShipModel> embedded();
+#endif
+
+    // Empty view if no sounding table exists for the key
+    // Getters with Value = float view a single precision copy of the tables, made on first use
+    template <class Value = double>
+    TableView<SoundingTableSchema, Value> getSoundingTable(const std::string& key) const;
+
+    // Compartments with a sounding table, sorted
+    std::vector<std::string> getSoundingKeys() const;
+
+    // Hold numbers range from 1 to holdCount
+    template <class Value = double>
+    TableView<CargoHoldSchema, Value> getCargoHold(int holdNumber) const;
+
+    template <class Value = double>
+    TableView<HydrostaticSchema, Value> getHydrostaticTable() const;
+
+    // Hash of the tables, telling apart results computed with different ship data, e.g. in a persisted cache
+    uint64_t getFingerprint() const;
+
+    // Draught moulded, LCF, LCB, VCB, KMT and MCT for the given displacement
+    std::tuple<double, double, double, double, double, double> interpolateHydrostatics(double displacement, Precision precision = Precision::Double) const;
+
+private:
+    // Publishes the arena into, and attaches models to, shared memory segments
+    friend class ShipModelSegment;
+    // Writes the arena and the extents as constant arrays
+    friend class ShipTableGenerator;
+
+    // Position of a table in the arena, in doubles from its start
+    struct TableExtent {
+        size_t offset;
+        size_t rowCount;
+    };
+
+    // The arena is owned by the model, mapped from a shared memory segment kept alive by segment, or compiled into the binary
+    std::vector<double> arena;
+    std::shared_ptr<const void> segment;
+    const double* arenaData;
+    size_t arenaLength;
+    // Single precision copy of the arena, with the same layout
+    mutable std::vector<float> singleArena;
+    mutable std::once_flag singleArenaFlag;
+    std::unordered_map<std::string, TableExtent> soundingExtents;
+    TableExtent holdExtents[holdCount];
+    TableExtent hydrostaticExtent;
+
+    // Empty model, filled in by ShipModelSegment or from the embedded tables
+    ShipModel();
+
+    // Join point of the concurrent reads
+    ShipModel(std::future<SoundingTablesReader> soundingFuture, std::vector<std::future<CargoHoldReader>> holdFutures,
+        std::future<HydrostaticsReader> hydroFuture);
+
+    static std::vector<std::future<CargoHoldReader>> readCargoHolds(const std::string& cargoHoldDirectory);
+
+    template <class Row>
+    TableExtent append(const std::vector<Row>& rows);
+
+    template <class Value>
+    const Value* arenaBase() const;
+
+    template <class Schema, class Value>
+    TableView<Schema, Value> view(const TableExtent& extent) const;
+};
+
+#endif // SHIPMODEL_H
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include "ShipModelSegment.h"
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#define LOADICATOR_POSIX_SHM 1
+#endif
+
+namespace {
+    const char segmentMagic[8] = { 'L', 'D', 'R', 'M', 'O', 'D', 'E', 'L' };
+    const char controlMagic[8] = { 'L', 'D', 'R', 'C', 'T', 'R', 'L', '1' };
+
+    // Extent of a table in the arena, in doubles from the start of the arena
+    struct SegmentExtent {
+        uint64_t offset;
+        uint64_t rowCount;
+    };
+
+    struct SegmentHeader {
+        char magic[8];
+        uint32_t layoutVersion;
+        uint32_t holdCount;
+        uint64_t generation;
+        uint64_t totalSize;
+        // Offsets in bytes from the start of the segment
+        uint64_t arenaOffset;
+        uint64_t arenaLength;
+        uint64_t directoryOffset;
+        uint64_t soundingCount;
+        SegmentExtent holds[ShipModel::holdCount];
+        SegmentExtent hydrostatics;
+    };
+
+    // One entry per sounding table; the key is stored after the directory, at keyOffset bytes from the start of the segment
+    struct DirectoryEntry {
+        uint64_t keyOffset;
+        uint64_t keyLength;
+        SegmentExtent extent;
+    };
+
+    struct ControlBlock {
+        char magic[8];
+        std::atomic<uint64_t> generation;
+    };
+}
+
+#ifdef LOADICATOR_POSIX_SHM
+
+namespace {
+    // A 64-bit atomic that is always lock-free is a plain word in memory, and thus valid across processes
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+        "Generations must be lock-free to be shared between processes.");
+
+    size_t alignUp(size_t size, size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // Maps the control segment, creating it if requested; returns nullptr if it does not exist
+    ControlBlock* mapControl(const std::string& name, bool create) {
+        int fd = shm_open(name.c_str(), create ? (O_CREAT | O_RDWR) : O_RDONLY, 0644);
+        if (fd < 0) {
+            if (!create && errno == ENOENT) {
+                return nullptr;
+            }
+            throw std::runtime_error("Unable to open shared memory segment " + name + ": " + std::strerror(errno));
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0) {
+            close(fd);
+            throw std::runtime_error("Unable to inspect shared memory segment " + name);
+        }
+        bool fresh = status.st_size == 0;
+        if (fresh && (!create || ftruncate(fd, sizeof(ControlBlock)) != 0)) {
+            close(fd);
+            throw std::runtime_error("Empty control segment " + name);
+        }
+        void* address = mmap(nullptr, sizeof(ControlBlock), create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error("Unable to map shared memory segment " + name);
+        }
+        ControlBlock* control = static_cast<ControlBlock*>(address);
+        if (fresh) {
+            std::memcpy(control->magic, controlMagic, sizeof(controlMagic));
+            new (&control->generation) std::atomic<uint64_t>(0);
+        }
+        else if (std::memcmp(control->magic, controlMagic, sizeof(controlMagic)) != 0) {
+            munmap(address, sizeof(ControlBlock));
+            throw std::runtime_error("Not a model control segment: " + name);
+        }
+        return control;
+    }
+}
+
+// Implementing the publish method
+uint64_t ShipModelSegment::publish(const ShipModel& model, const std::string& name) {
+    // Layout: header, arena (aligned for vectorized reads), directory, keys
+    std::vector<std::pair<const std::string*, const ShipModel::TableExtent*>> tables;
+    for (const auto& pair : model.soundingExtents) {
+        tables.emplace_back(&pair.first, &pair.second);
+    }
+    const size_t arenaOffset = alignUp(sizeof(SegmentHeader), 64);
+    const size_t directoryOffset = alignUp(arenaOffset + model.arenaLength * sizeof(double), 8);
+    size_t totalSize = directoryOffset + tables.size() * sizeof(DirectoryEntry);
+    for (const auto& table : tables) {
+        totalSize += table.first->size();
+    }
+
+    ControlBlock* control = mapControl("/" + name, true);
+    const uint64_t previous = control->generation.load(std::memory_order_acquire);
+    const uint64_t generation = previous + 1;
+    const std::string segment = segmentName(name, generation);
+
+    shm_unlink(segment.c_str());
+    int fd = shm_open(segment.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, totalSize) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        munmap(control, sizeof(ControlBlock));
+        throw std::runtime_error("Unable to create shared memory segment " + segment);
+    }
+    void* address = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        munmap(control, sizeof(ControlBlock));
+        throw std::runtime_error("Unable to map shared memory segment " + segment);
+    }
+
+    char* base = static_cast<char*>(address);
+    SegmentHeader* header = reinterpret_cast<SegmentHeader*>(base);
+    std::memcpy(header->magic, segmentMagic, sizeof(segmentMagic));
+    header->layoutVersion = layoutVersion;
+    header->holdCount = ShipModel::holdCount;
+    header->generation = generation;
+    header->totalSize = totalSize;
+    header->arenaOffset = arenaOffset;
+    header->arenaLength = model.arenaLength;
+    header->directoryOffset = directoryOffset;
+    header->soundingCount = tables.size();
+    for (int i = 0; i < ShipModel::holdCount; ++i) {
+        header->holds[i] = { model.holdExtents[i].offset, model.holdExtents[i].rowCount };
+    }
+    header->hydrostatics = { model.hydrostaticExtent.offset, model.hydrostaticExtent.rowCount };
+    std::memcpy(base + arenaOffset, model.arenaData, model.arenaLength * sizeof(double));
+
+    DirectoryEntry* directory = reinterpret_cast<DirectoryEntry*>(base + directoryOffset);
+    size_t keyOffset = directoryOffset + tables.size() * sizeof(DirectoryEntry);
+    for (size_t i = 0; i < tables.size(); ++i) {
+        const std::string& key = *tables[i].first;
+        directory[i] = { keyOffset, key.size(), { tables[i].second->offset, tables[i].second->rowCount } };
+        std::memcpy(base + keyOffset, key.data(), key.size());
+        keyOffset += key.size();
+    }
+    munmap(address, totalSize);
+
+    // The new generation becomes visible only once its segment is complete
+    control->generation.store(generation, std::memory_order_release);
+    munmap(control, sizeof(ControlBlock));
+
+    if (previous != 0) {
+        shm_unlink(segmentName(name, previous).c_str());
+    }
+    return generation;
+}
+
+// Implementing the attach method
+std::shared_ptr<const ShipModel> ShipModelSegment::attach(const std::string& name, uint64_t& generation) {
+    ControlBlock* control = mapControl("/" + name, false);
+    if (!control) {
+        throw std::runtime_error("No ship model has been published as " + name);
+    }
+
+    // A publisher may remove the generation just read; the control segment then already holds a newer one
+    int fd = -1;
+    for (int attempt = 0; attempt < 100 && fd < 0; ++attempt) {
+        generation = control->generation.load(std::memory_order_acquire);
+        fd = shm_open(segmentName(name, generation).c_str(), O_RDONLY, 0);
+    }
+    munmap(control, sizeof(ControlBlock));
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open the published ship model " + name);
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(SegmentHeader)) {
+        close(fd);
+        throw std::runtime_error("Truncated ship model segment " + name);
+    }
+    const size_t size = static_cast<size_t>(status.st_size);
+    void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Unable to map ship model segment " + name);
+    }
+    std::shared_ptr<const void> mapping(address, [size](const void* mapped) { munmap(const_cast<void*>(mapped), size); });
+
+    const char* base = static_cast<const char*>(address);
+    const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(base);
+    if (std::memcmp(header->magic, segmentMagic, sizeof(segmentMagic)) != 0 || header->layoutVersion != layoutVersion
+        || header->holdCount != ShipModel::holdCount || header->totalSize != size || header->generation != generation
+        || header->arenaOffset + header->arenaLength * sizeof(double) > header->directoryOffset
+        || header->directoryOffset + header->soundingCount * sizeof(DirectoryEntry) > size) {
+        throw std::runtime_error("Incompatible ship model segment " + name);
+    }
+
+    std::shared_ptr<ShipModel> model(new ShipModel());
+    model->segment = mapping;
+    model->arenaData = reinterpret_cast<const double*>(base + header->arenaOffset);
+    model->arenaLength = header->arenaLength;
+    auto checked = [header](const SegmentExtent& extent, size_t columnCount) {
+        if (extent.offset + extent.rowCount * columnCount > header->arenaLength) {
+            throw std::runtime_error("Table extends beyond the arena of the ship model segment.");
+        }
+        return ShipModel::TableExtent{ extent.offset, extent.rowCount };
+    };
+    for (int i = 0; i < ShipModel::holdCount; ++i) {
+        model->holdExtents[i] = checked(header->holds[i], CargoHoldSchema::columnCount);
+    }
+    model->hydrostaticExtent = checked(header->hydrostatics, HydrostaticSchema::columnCount);
+    const DirectoryEntry* directory = reinterpret_cast<const DirectoryEntry*>(base + header->directoryOffset);
+    for (size_t i = 0; i < header->soundingCount; ++i) {
+        if (directory[i].keyOffset + directory[i].keyLength > size) {
+            throw std::runtime_error("Sounding table key beyond the ship model segment.");
+        }
+        std::string key(base + directory[i].keyOffset, directory[i].keyLength);
+        model->soundingExtents[key] = checked(directory[i].extent, SoundingTableSchema::columnCount);
+    }
+    return model;
+}
+
+// Implementing the currentGeneration method
+uint64_t ShipModelSegment::currentGeneration(const std::string& name) {
+    ControlBlock* control = mapControl("/" + name, false);
+    if (!control) {
+        return 0;
+    }
+    uint64_t generation = control->generation.load(std::memory_order_acquire);
+    munmap(control, sizeof(ControlBlock));
+    return generation;
+}
+
+// Implementing the remove method
+void ShipModelSegment::remove(const std::string& name) {
+    uint64_t generation = currentGeneration(name);
+    if (generation != 0) {
+        shm_unlink(segmentName(name, generation).c_str());
+    }
+    shm_unlink(("/" + name).c_str());
+}
+
+#else
+
+// Implementing the publish method
+uint64_t ShipModelSegment::publish(const ShipModel& /*model*/, const std::string& /*name*/) {
+    throw std::runtime_error("Shared memory segments are only available on POSIX systems.");
+}
+
+// Implementing the attach method
+std::shared_ptr<const ShipModel> ShipModelSegment::attach(const std::string& /*name*/, uint64_t& /*generation*/) {
+    throw std::runtime_error("Shared memory segments are only available on POSIX systems.");
+}
+
+// Implementing the currentGeneration method
+uint64_t ShipModelSegment::currentGeneration(const std::string& /*name*/) {
+    return 0;
+}
+
+// Implementing the remove method
+void ShipModelSegment::remove(const std::string& /*name*/) {
+}
+
+#endif
+
+// Implementing the segmentName method
+std::string ShipModelSegment::segmentName(const std::string& name, uint64_t generation) {
+    return "/" + name + "." + std::to_string(generation);
+}
\ No newline at end of file
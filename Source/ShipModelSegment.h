@@ -0,0 +1,37 @@
+#ifndef SHIPMODELSEGMENT_H
+#define SHIPMODELSEGMENT_H
+
+#include "ShipModel.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+// Read-only POSIX shared memory segments holding a loaded ShipModel, so that worker processes share one physical copy
+// A segment holds a header, the arena and a directory of the sounding tables, addressed by offsets from its start rather than pointers
+// Each publication creates a new segment "<name>.<generation>" and then advances the generation held by the control segment "<name>",
+// so that attaching processes always find a complete model; mappings of older generations remain valid until they are released
+class ShipModelSegment {
+public:
+    // Publishes the model as the next generation, and removes the segment of the previous one
+    // Only one process is expected to publish under a given name at a time
+    static uint64_t publish(const ShipModel& model, const std::string& name);
+
+    // Maps the current generation read-only; the model keeps the mapping alive
+    static std::shared_ptr<const ShipModel> attach(const std::string& name, uint64_t& generation);
+
+    // Generation last published under the name, or 0 if there is none
+    // Workers compare it with the generation they attached to, and attach again when it has moved on
+    static uint64_t currentGeneration(const std::string& name);
+
+    // Removes the current generation and the control segment
+    static void remove(const std::string& name);
+
+private:
+    // Layout version of the segments; attaching to a segment of another layout fails
+    static const uint32_t layoutVersion = 1;
+
+    static std::string segmentName(const std::string& name, uint64_t generation);
+};
+
+#endif // SHIPMODELSEGMENT_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "ShipTableGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Implementing the generate method
+void ShipTableGenerator::generate(const ShipModel& model, const std::string& fileName) {
+    if (model.arenaLength == 0 || model.soundingExtents.empty()) {
+        throw std::runtime_error("The ship model has no tables to embed.");
+    }
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + fileName + " for writing.");
+    }
+    // The keys are written sorted, so that the output depends on the data only
+    std::vector<std::string> keys = model.getSoundingKeys();
+    char number[32];
+
+    file << "#ifndef EMBEDDEDSHIPTABLES_H\n#define EMBEDDEDSHIPTABLES_H\n\n";
+    file << "// Generated by loadicator --generate-tables from the sounding tables, cargo hold files and hydrostatic tables\n";
+    file << "// Regenerate it rather than editing it; it is only included by ShipModel.cpp, built with LOADICATOR_EMBEDDED_TABLES\n\n";
+    file << "#include <cstddef>\n#include <cstdint>\n\n";
+    file << "namespace EmbeddedShipTables {\n";
+    file << "    struct Extent {\n        std::size_t offset;\n        std::size_t rowCount;\n    };\n\n";
+    file << "    struct SoundingEntry {\n        const char* key;\n        Extent extent;\n    };\n\n";
+    file << "    constexpr std::size_t arenaLength = " << model.arenaLength << ";\n";
+    file << "    constexpr std::uint64_t fingerprint = " << model.getFingerprint() << "ull;\n\n";
+
+    file << "    constexpr std::size_t holdCount = " << ShipModel::holdCount << ";\n";
+    file << "    constexpr Extent holds[holdCount] = {\n";
+    for (int i = 0; i < ShipModel::holdCount; ++i) {
+        file << "        { " << model.holdExtents[i].offset << ", " << model.holdExtents[i].rowCount << " },\n";
+    }
+    file << "    };\n";
+    file << "    constexpr Extent hydrostatics = { " << model.hydrostaticExtent.offset << ", " << model.hydrostaticExtent.rowCount << " };\n\n";
+
+    file << "    constexpr std::size_t soundingCount = " << keys.size() << ";\n";
+    file << "    constexpr SoundingEntry soundings[soundingCount] = {\n";
+    for (const std::string& key : keys) {
+        const ShipModel::TableExtent& extent = model.soundingExtents.at(key);
+        file << "        { \"" << escape(key) << "\", { " << extent.offset << ", " << extent.rowCount << " } },\n";
+    }
+    file << "    };\n\n";
+
+    file << "    alignas(64) constexpr double arena[arenaLength] = {\n";
+    for (size_t i = 0; i < model.arenaLength; ++i) {
+        if (!std::isfinite(model.arenaData[i])) {
+            throw std::runtime_error("Non-finite table value at arena offset " + std::to_string(i));
+        }
+        snprintf(number, sizeof(number), "%.17g", model.arenaData[i]);
+        file << ((i % 6 == 0) ? "        " : " ") << number << ((i + 1 < model.arenaLength) ? "," : "");
+        if (i % 6 == 5 || i + 1 == model.arenaLength) {
+            file << '\n';
+        }
+    }
+    file << "    };\n";
+    file << "}\n\n#endif // EMBEDDEDSHIPTABLES_H\n";
+    if (!file) {
+        throw std::runtime_error("Failed to write " + fileName);
+    }
+}
+
+// Implementing the escape method
+std::string ShipTableGenerator::escape(const std::string& key) {
+    std::string escaped;
+    for (char c : key) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef SHIPTABLEGENERATOR_H
+#define SHIPTABLEGENERATOR_H
+
+#include "ShipModel.h"
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+// Build step for the ships of a fixed fleet: writes the tables of a loaded model as a C++ header of constexpr arrays,
+// in the layout of the arena, together with the extents of every table
+// Compiled with LOADICATOR_EMBEDDED_TABLES, ShipModel.cpp includes the header and ShipModel::loadAsync returns the embedded model,
+// so that the binary starts without reading or parsing any data file
+class ShipTableGenerator {
+public:
+    // Values are written with 17 significant digits, so that the embedded arena, and thus the fingerprint of the model, is unchanged
+    static void generate(const ShipModel& model, const std::string& fileName);
+
+private:
+    static std::string escape(const std::string& key);
+};
+
+#endif // SHIPTABLEGENERATOR_H
\ No newline at end of file
@@ -1,24 +1,34 @@
 #include "SoundingTablesReader.h"
 
 // Implementing the constructor
+SoundingTablesReader::SoundingTablesReader(const std::string& fileName) {
+    readFile(fileName, nullptr);
+}
+
+// Implementing the constructor for a given tank plan
 SoundingTablesReader::SoundingTablesReader(const std::string& fileName, const std::unordered_map<std::string, std::vector<double>>& tankPlan) {
-    readFile(fileName, tankPlan);
+    readFile(fileName, &tankPlan);
 }
 
 // Implementing the getData method
-const std::vector<std::vector<double>>& SoundingTablesReader::getData(const std::string& key) const {
+const std::vector<SoundingTableSchema::Row>& SoundingTablesReader::getData(const std::string& key) const {
     auto it = soundingData.find(key);
     if (it != soundingData.end()) {
         return it->second;
     }
     else {
-        static const std::vector<std::vector<double>> emptyMatrix;
+        static const std::vector<SoundingTableSchema::Row> emptyMatrix;
         return emptyMatrix;
     }
 }
 
+// Implementing the getAllData method
+const std::unordered_map<std::string, std::vector<SoundingTableSchema::Row>>& SoundingTablesReader::getAllData() const {
+    return soundingData;
+}
+
 // Implementing the readFile method
-void SoundingTablesReader::readFile(const std::string& fileName, const std::unordered_map<std::string, std::vector<double>>& tankPlan) {
+void SoundingTablesReader::readFile(const std::string& fileName, const std::unordered_map<std::string, std::vector<double>>* tankPlan) {
     std::ifstream file(fileName);
     if (!file.is_open()) {
         throw std::runtime_error("Unable to open file " + fileName);
@@ -26,71 +36,55 @@ void SoundingTablesReader::readFile(const std::string& fileName, const std::unor
 
     std::string line;
     std::string currentKey;
-    std::vector<std::vector<double>> currentMatrix;
+    std::vector<SoundingTableSchema::Row> currentMatrix;
+    SoundingTableSchema::Row row;
+    size_t count = 0;
     int skipCount = 0;
-    bool capturing = false;
 
-    // Regular expressions to identify useful data
+    // Regular expression to identify the compartment of each table
     std::regex keyRegex(R"(Compartment ident: (\S+))");
-    std::regex dashRegex(R"(-{3,})");
 
     while (std::getline(file, line)) {
         line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](unsigned char ch) {
             return !std::isspace(ch);
             }));
 
+        // Every table starts with its compartment ident, which also ends the previous table
+        // Plain searches come first, as the regular expression is much slower on the 1 MB file
         std::smatch match;
-        if (std::regex_search(line, match, keyRegex)) {
-            std::string foundKey = match[1].str();
-            if (tankPlan.find(foundKey) != tankPlan.end()) {
-                if (!currentKey.empty() && !currentMatrix.empty()) {
-                    soundingData[currentKey] = currentMatrix;
-                }
-                currentKey = foundKey;
-                currentMatrix.clear();
-                // skipCount set according to the form of the TXT file
-                skipCount = 19;
-                capturing = false;
-            }
-            else if (capturing) {
-                break;
+        if (line.find("Compartment ident:") != std::string::npos && std::regex_search(line, match, keyRegex)) {
+            if (!currentKey.empty() && !currentMatrix.empty()) {
+                soundingData[currentKey] = currentMatrix;
             }
+            std::string foundKey = match[1].str();
+            currentKey = (!tankPlan || tankPlan->find(foundKey) != tankPlan->end()) ? foundKey : "";
+            currentMatrix.clear();
+            count = 0;
+            // skipCount set according to the form of the TXT file
+            skipCount = 19;
         }
 
-        if (!currentKey.empty()) {
-            if (skipCount > 0) {
-                --skipCount;
-            }
-            else if (std::regex_search(line, dashRegex)) {
-                soundingData[currentKey] = currentMatrix;
-                currentKey = "";
-                currentMatrix.clear();
-                capturing = false;
+        if (currentKey.empty()) {
+            continue;
+        }
+        if (skipCount > 0) {
+            --skipCount;
+        }
+        else if (line.find("---") != std::string::npos) {
+            soundingData[currentKey] = currentMatrix;
+            currentKey = "";
+            currentMatrix.clear();
+        }
+        else {
+            // A row may be split over several lines of the TXT file
+            // Rows holding more numbers than the schema are misread lines, and are dropped
+            std::istringstream iss(line);
+            if (!readColumns<SoundingTableSchema>(iss, row, count)) {
+                count = 0;
             }
-            else {
-                capturing = true;
-
-                std::istringstream iss(line);
-                std::vector<double> doubles;
-                double value;
-                while (iss >> value) {
-                    doubles.push_back(value);
-                }
-                // 13 is the number of data columns to be stored
-                while (doubles.size() < 13 && std::getline(file, line)) {
-                    line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](unsigned char ch) {
-                        return !std::isspace(ch);
-                        }));
-
-                    std::istringstream iss_next(line);
-                    while (iss_next >> value) {
-                        doubles.push_back(value);
-                    }
-                }
-
-                if (doubles.size() == 13) {
-                    currentMatrix.push_back(doubles);
-                }
+            else if (count == SoundingTableSchema::columnCount) {
+                currentMatrix.push_back(row);
+                count = 0;
             }
         }
     }
@@ -9,17 +9,24 @@
 #include <regex>
 #include <cctype>
 #include <iostream>
+#include "TableSchemas.h"
 
 class SoundingTablesReader {
 public:
+    // Reads the tables of every compartment in the file
+    SoundingTablesReader(const std::string& fileName);
+
+    // Reads only the tables of the compartments in tankPlan
     SoundingTablesReader(const std::string& fileName, const std::unordered_map<std::string, std::vector<double>>& tankPlan);
 
-    const std::vector<std::vector<double>>& getData(const std::string& key) const;
+    const std::vector<SoundingTableSchema::Row>& getData(const std::string& key) const;
+
+    const std::unordered_map<std::string, std::vector<SoundingTableSchema::Row>>& getAllData() const;
 
 private:
-    std::unordered_map<std::string, std::vector<std::vector<double>>> soundingData;
+    std::unordered_map<std::string, std::vector<SoundingTableSchema::Row>> soundingData;
 
-    void readFile(const std::string& fileName, const std::unordered_map<std::string, std::vector<double>>& tankPlan);
+    void readFile(const std::string& fileName, const std::unordered_map<std::string, std::vector<double>>* tankPlan);
 };
 
 #endif // SOUNDINGTABLESREADER_H
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "SoundingTrimTable.h"
+#include <algorithm>
+#include <cmath>
+
+typedef SoundingTableSchema Schema;
+
+// Definitions of the trim arrays, which are read at run time; required before C++17, where constexpr members are not implicitly inline
+constexpr size_t SoundingTableSchema::trimColumns[];
+constexpr double SoundingTableSchema::trimValues[];
+
+// Implementing the constructor
+SoundingTrimTable::SoundingTrimTable(const ShipModel& model, const std::vector<std::string>& keys)
+    : keys(keys) {
+    for (const std::string& key : keys) {
+        TableView<Schema> soundingData = model.getSoundingTable(key);
+        size_t offset = soundingColumn.size();
+        for (size_t r = 0; r < soundingData.size(); ++r) {
+            const double* row = soundingData[r];
+            // Rows that break the ordering of sounding or even keel volume are misread lines of the TXT file
+            if (soundingColumn.size() > offset && (row[Schema::Sounding::index] <= soundingColumn.back() || row[Schema::Volume::index] < volumeColumns[Schema::levelTrim].back())) {
+                continue;
+            }
+            soundingColumn.push_back(row[Schema::Sounding::index]);
+            for (size_t j = 0; j < trimCount; ++j) {
+                volumeColumns[j].push_back(row[Schema::trimColumns[j]]);
+            }
+            lcgColumn.push_back(row[Schema::LCG::index]);
+            tcgColumn.push_back(row[Schema::TCG::index]);
+            vcgColumn.push_back(row[Schema::VCG::index]);
+            IMOMColumn.push_back(row[Schema::IMOM::index]);
+        }
+
+        size_t rowCount = soundingColumn.size() - offset;
+        // Ensure every table has at least two rows for interpolation
+        if (rowCount < 2) {
+            throw std::runtime_error("Insufficient sounding data for interpolation: " + key);
+        }
+
+        // Evenly spaced soundings allow the rows to be found without searching
+        double step = soundingColumn[offset + 1] - soundingColumn[offset];
+        for (size_t i = offset + 2; i < soundingColumn.size(); ++i) {
+            if (std::abs(soundingColumn[i] - soundingColumn[i - 1] - step) > 1e-9) {
+                step = 0.0;
+                break;
+            }
+        }
+
+        indices[key] = offsets.size();
+        offsets.push_back(offset);
+        rowCounts.push_back(rowCount);
+        steps.push_back(step);
+    }
+}
+
+// Implementing the getKeys method
+const std::vector<std::string>& SoundingTrimTable::getKeys() const {
+    return keys;
+}
+
+// Implementing the find method
+size_t SoundingTrimTable::find(const std::string& key) const {
+    auto it = indices.find(key);
+    return (it == indices.end()) ? npos : it->second;
+}
+
+// Implementing the interpolate method
+void SoundingTrimTable::interpolate(const std::vector<double>& soundings, double trim, SoundingResults& results) const {
+    const size_t tankCount = keys.size();
+    if (soundings.size() != tankCount) {
+        throw std::invalid_argument("Number of soundings does not match the number of tanks.");
+    }
+    results.volume.resize(tankCount);
+    results.lcg.resize(tankCount);
+    results.tcg.resize(tankCount);
+    results.vcg.resize(tankCount);
+    results.IMOM.resize(tankCount);
+    results.row.resize(tankCount);
+    results.fraction.resize(tankCount);
+
+    // Trim columns bracketing the current trim, shared by all tanks
+    size_t j;
+    const double trimFraction = bracketTrim(trim, j);
+
+    // Find the sounding rows for which interpolation is to be performed
+    for (size_t k = 0; k < tankCount; ++k) {
+        results.row[k] = soundingRow(k, soundings[k], results.fraction[k]);
+    }
+
+    // Bilinear interpolation of the volume, without branches so that the loop vectorizes across tanks
+    const double* lower = volumeColumns[j].data();
+    const double* upper = volumeColumns[j + 1].data();
+    for (size_t k = 0; k < tankCount; ++k) {
+        const size_t r = results.row[k];
+        const double volume1 = lower[r] + trimFraction * (upper[r] - lower[r]);
+        const double volume2 = lower[r + 1] + trimFraction * (upper[r + 1] - lower[r + 1]);
+        results.volume[k] = volume1 + results.fraction[k] * (volume2 - volume1);
+    }
+
+    // Find the even keel rows holding the same volume
+    for (size_t k = 0; k < tankCount; ++k) {
+        results.row[k] = levelRow(k, results.volume[k], results.fraction[k]);
+    }
+
+    // Linear interpolation of LCG, TCG, VCG and IMOM
+    const double* lcg = lcgColumn.data();
+    const double* tcg = tcgColumn.data();
+    const double* vcg = vcgColumn.data();
+    const double* IMOM = IMOMColumn.data();
+    for (size_t k = 0; k < tankCount; ++k) {
+        const size_t r = results.row[k];
+        const double fraction = results.fraction[k];
+        results.lcg[k] = lcg[r] + fraction * (lcg[r + 1] - lcg[r]);
+        results.tcg[k] = tcg[r] + fraction * (tcg[r + 1] - tcg[r]);
+        results.vcg[k] = vcg[r] + fraction * (vcg[r + 1] - vcg[r]);
+        results.IMOM[k] = std::max(IMOM[r] + fraction * (IMOM[r + 1] - IMOM[r]), 0.0);
+    }
+}
+
+// Implementing the interpolate method for a single tank
+std::tuple<double, double, double, double, double> SoundingTrimTable::interpolate(size_t tank, double sounding, double trim) const {
+    if (tank >= keys.size()) {
+        throw std::out_of_range("Non-existent tank index in sounding table.");
+    }
+    size_t j;
+    const double trimFraction = bracketTrim(trim, j);
+
+    double fraction;
+    size_t r = soundingRow(tank, sounding, fraction);
+    const double* lower = volumeColumns[j].data();
+    const double* upper = volumeColumns[j + 1].data();
+    const double volume1 = lower[r] + trimFraction * (upper[r] - lower[r]);
+    const double volume2 = lower[r + 1] + trimFraction * (upper[r + 1] - lower[r + 1]);
+    const double volume = volume1 + fraction * (volume2 - volume1);
+
+    r = levelRow(tank, volume, fraction);
+    const double lcg = lcgColumn[r] + fraction * (lcgColumn[r + 1] - lcgColumn[r]);
+    const double tcg = tcgColumn[r] + fraction * (tcgColumn[r + 1] - tcgColumn[r]);
+    const double vcg = vcgColumn[r] + fraction * (vcgColumn[r + 1] - vcgColumn[r]);
+    const double IMOM = std::max(IMOMColumn[r] + fraction * (IMOMColumn[r + 1] - IMOMColumn[r]), 0.0);
+
+    return std::make_tuple(volume, lcg, tcg, vcg, IMOM);
+}
+
+// Implementing the bracketTrim method
+// Trims beyond the tabulated range are clamped rather than extrapolated
+double SoundingTrimTable::bracketTrim(double trim, size_t& j) {
+    double clampedTrim = std::min(std::max(trim, Schema::trimValues[0]), Schema::trimValues[trimCount - 1]);
+    j = 0;
+    while (j + 2 < trimCount && clampedTrim > Schema::trimValues[j + 1]) {
+        ++j;
+    }
+    return (clampedTrim - Schema::trimValues[j]) / (Schema::trimValues[j + 1] - Schema::trimValues[j]);
+}
+
+// Implementing the soundingRow method
+size_t SoundingTrimTable::soundingRow(size_t tank, double sounding, double& fraction) const {
+    const double* column = soundingColumn.data();
+    const size_t offset = offsets[tank];
+    const size_t rowCount = rowCounts[tank];
+    const double value = std::min(std::max(sounding, column[offset]), column[offset + rowCount - 1]);
+    size_t i = (steps[tank] > 0.0)
+        ? std::min(static_cast<size_t>((value - column[offset]) / steps[tank]), rowCount - 2)
+        : findRow(column + offset, rowCount, value);
+    fraction = (value - column[offset + i]) / (column[offset + i + 1] - column[offset + i]);
+    return offset + i;
+}
+
+// Implementing the levelRow method
+size_t SoundingTrimTable::levelRow(size_t tank, double volume, double& fraction) const {
+    const double* level = volumeColumns[Schema::levelTrim].data();
+    const size_t offset = offsets[tank];
+    const size_t i = offset + findRow(level + offset, rowCounts[tank], volume);
+    const double span = level[i + 1] - level[i];
+    fraction = std::min(std::max((span > 0.0) ? (volume - level[i]) / span : 0.0, 0.0), 1.0);
+    return i;
+}
+
+// Implementing the findRow method
+// Index i of the interval column[i] <= value < column[i + 1], clamped to the first and last interval
+size_t SoundingTrimTable::findRow(const double* column, size_t rowCount, double value) {
+    const double* position = std::upper_bound(column + 1, column + rowCount - 1, value);
+    return static_cast<size_t>(position - column) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef SOUNDINGTRIMTABLE_H
+#define SOUNDINGTRIMTABLE_H
+
+#include "ShipModel.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <tuple>
+#include <stdexcept>
+
+// Per-tank outputs of SoundingTrimTable::interpolate, ordered as the table keys
+// The same instance can be reused between calls, so that no memory is allocated in steady state
+struct SoundingResults {
+    std::vector<double> volume, lcg, tcg, vcg, IMOM;
+
+    // Scratch space for the row searches
+    std::vector<size_t> row;
+    std::vector<double> fraction;
+};
+
+// Sounding tables of several tanks packed column by column, for interpolation on (sounding, trim)
+// Volumes are interpolated bilinearly on the sounding rows and the seven trim columns
+// Centroids and IMOM are only tabulated for even keel, so they are read at the even keel row holding the same volume
+class SoundingTrimTable {
+public:
+    SoundingTrimTable(const ShipModel& model, const std::vector<std::string>& keys);
+
+    static const size_t npos = static_cast<size_t>(-1);
+
+    const std::vector<std::string>& getKeys() const;
+
+    // Position of the key in getKeys(), or npos
+    size_t find(const std::string& key) const;
+
+    // Soundings in cm, one per key; trim in m, with the sign convention of the "Tr=" columns
+    void interpolate(const std::vector<double>& soundings, double trim, SoundingResults& results) const;
+
+    // Volume, LCG, TCG, VCG and IMOM of a single tank, e.g. when only its gauge reading has changed
+    std::tuple<double, double, double, double, double> interpolate(size_t tank, double sounding, double trim) const;
+
+private:
+    static const size_t trimCount = SoundingTableSchema::trimCount;
+
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, size_t> indices;
+    std::vector<size_t> offsets;
+    std::vector<size_t> rowCounts;
+    // Sounding interval of each table, or 0.0 when the rows are not evenly spaced
+    std::vector<double> steps;
+
+    // Row data of every table, concatenated
+    std::vector<double> soundingColumn;
+    std::vector<double> volumeColumns[trimCount];
+    std::vector<double> lcgColumn, tcgColumn, vcgColumn, IMOMColumn;
+
+    static size_t findRow(const double* column, size_t rowCount, double value);
+
+    // Lower of the two trim columns bracketing the trim, and the interpolation fraction between them
+    static double bracketTrim(double trim, size_t& j);
+
+    // Sounding row of the tank and fraction towards the next one
+    size_t soundingRow(size_t tank, double sounding, double& fraction) const;
+
+    // Even keel row of the tank holding the volume and fraction towards the next one
+    size_t levelRow(size_t tank, double volume, double& fraction) const;
+};
+
+#endif // SOUNDINGTRIMTABLE_H
\ No newline at end of file
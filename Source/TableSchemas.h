@@ -0,0 +1,184 @@
+#ifndef TABLESCHEMAS_H
+#define TABLESCHEMAS_H
+
+#include <array>
+#include <vector>
+#include <tuple>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+// Compile-time description of the column layouts of the data files
+// Kernels name the columns they need through these descriptors, so that a layout change
+// which moves or removes a column fails to compile instead of silently misreading data
+
+template <size_t Index>
+struct TableColumn {
+    static constexpr size_t index = Index;
+};
+
+// Sounding tables: sounding [cm], volume [m3] at Tr=0, -0.5, -1, -1.5, -2, -2.5 and 0.5,
+// then FILL [%], L.C.G, T.C.G, V.C.G [m] and IMOM [m4], the last four at even keel
+struct SoundingTableSchema {
+    static constexpr size_t columnCount = 13;
+    typedef std::array<double, columnCount> Row;
+
+    typedef TableColumn<0> Sounding;
+    typedef TableColumn<1> Volume;
+    typedef TableColumn<8> Fill;
+    typedef TableColumn<9> LCG;
+    typedef TableColumn<10> TCG;
+    typedef TableColumn<11> VCG;
+    typedef TableColumn<12> IMOM;
+
+    // Volume columns sorted by increasing trim, and the corresponding trims [m]
+    static constexpr size_t trimCount = 7;
+    static constexpr size_t levelTrim = 5;
+    static constexpr size_t trimColumns[trimCount] = { 6, 5, 4, 3, 2, 1, 7 };
+    static constexpr double trimValues[trimCount] = { -2.5, -2.0, -1.5, -1.0, -0.5, 0.0, 0.5 };
+};
+
+// Cargo hold files: sounding, volume, LCG, TCG, VCG and FSM
+struct CargoHoldSchema {
+    static constexpr size_t columnCount = 6;
+    typedef std::array<double, columnCount> Row;
+
+    typedef TableColumn<0> Sounding;
+    typedef TableColumn<1> Volume;
+    typedef TableColumn<2> LCG;
+    typedef TableColumn<3> TCG;
+    typedef TableColumn<4> VCG;
+    typedef TableColumn<5> FSM;
+};
+
+// Hydrostatic tables, as laid out in the PDF; only the columns used by the project are named
+// LCF and LCB are measured from midship
+struct HydrostaticSchema {
+    static constexpr size_t columnCount = 30;
+    typedef std::array<double, columnCount> Row;
+
+    typedef TableColumn<0> Draught;
+    typedef TableColumn<1> Displacement;
+    typedef TableColumn<4> LCF;
+    typedef TableColumn<5> LCB;
+    typedef TableColumn<6> VCB;
+    typedef TableColumn<7> KMT;
+    typedef TableColumn<11> MCT;
+};
+
+// Rows of a schema must be laid out exactly like consecutive doubles, so that tables can be viewed in place
+static_assert(sizeof(SoundingTableSchema::Row) == SoundingTableSchema::columnCount * sizeof(double), "Padded sounding table rows.");
+static_assert(sizeof(CargoHoldSchema::Row) == CargoHoldSchema::columnCount * sizeof(double), "Padded cargo hold rows.");
+static_assert(sizeof(HydrostaticSchema::Row) == HydrostaticSchema::columnCount * sizeof(double), "Padded hydrostatic rows.");
+
+// Checks that every column of a kernel belongs to the schema
+template <class Schema, class... Columns>
+constexpr bool columnsInSchema() {
+    bool inSchema = true;
+    for (size_t index : { Columns::index... }) {
+        inSchema = inSchema && index < Schema::columnCount;
+    }
+    return inSchema;
+}
+
+template <class Schema>
+constexpr bool trimColumnsInSchema() {
+    bool inSchema = true;
+    for (size_t j = 0; j < Schema::trimCount; ++j) {
+        inSchema = inSchema && Schema::trimColumns[j] < Schema::columnCount && Schema::trimColumns[j] != Schema::Fill::index;
+    }
+    return inSchema && Schema::trimColumns[Schema::levelTrim] == Schema::Volume::index && Schema::trimValues[Schema::levelTrim] == 0.0;
+}
+
+static_assert(columnsInSchema<SoundingTableSchema, SoundingTableSchema::Sounding, SoundingTableSchema::Volume, SoundingTableSchema::Fill,
+    SoundingTableSchema::LCG, SoundingTableSchema::TCG, SoundingTableSchema::VCG, SoundingTableSchema::IMOM>(), "Sounding table column outside of the schema.");
+static_assert(trimColumnsInSchema<SoundingTableSchema>(), "Trim columns do not match the sounding table schema.");
+static_assert(columnsInSchema<CargoHoldSchema, CargoHoldSchema::Sounding, CargoHoldSchema::Volume, CargoHoldSchema::LCG,
+    CargoHoldSchema::TCG, CargoHoldSchema::VCG, CargoHoldSchema::FSM>(), "Cargo hold column outside of the schema.");
+static_assert(columnsInSchema<HydrostaticSchema, HydrostaticSchema::Draught, HydrostaticSchema::Displacement, HydrostaticSchema::LCF,
+    HydrostaticSchema::LCB, HydrostaticSchema::VCB, HydrostaticSchema::KMT, HydrostaticSchema::MCT>(), "Hydrostatic column outside of the schema.");
+
+// Read-only view over the rows of a table stored contiguously, row after row, e.g. in the arena of a ShipModel
+// Views are cheap to copy and never own or allocate memory
+// Value is float for the single precision copy of the tables, which halves the memory read by the kernels
+template <class Schema, class Value = double>
+class TableView {
+public:
+    TableView() : data(nullptr), rowCount(0) {}
+    TableView(const Value* data, size_t rowCount) : data(data), rowCount(rowCount) {}
+
+    size_t size() const { return rowCount; }
+    bool empty() const { return rowCount == 0; }
+
+    // Rows are returned as pointers to their first column
+    const Value* operator[](size_t i) const { return data + i * Schema::columnCount; }
+    const Value* back() const { return (*this)[rowCount - 1]; }
+
+private:
+    const Value* data;
+    size_t rowCount;
+};
+
+// Reads numbers from the stream into row, starting at column count
+// Returns false if the stream holds more numbers than the schema has columns
+template <class Schema>
+bool readColumns(std::istream& stream, typename Schema::Row& row, size_t& count) {
+    double value;
+    while (stream >> value) {
+        if (count == Schema::columnCount) {
+            return false;
+        }
+        row[count++] = value;
+    }
+    return true;
+}
+
+// Each interpolated column yields a double
+template <class Column>
+using ColumnValue = double;
+
+// Linear interpolation of the given columns between the two rows nearest to value in column Key
+// Returns the interpolated values in the order of Columns
+// The search and the interpolation are carried out in the precision of the view; the values are returned as doubles
+template <class Schema, class Key, class... Columns, class Value>
+std::tuple<ColumnValue<Columns>...> interpolateNearest(TableView<Schema, Value> rows, double value) {
+    static_assert(columnsInSchema<Schema, Key, Columns...>(), "Interpolated column outside of the schema.");
+
+    // Ensure there are at least two rows for interpolation
+    if (rows.size() < 2) {
+        throw std::runtime_error("Insufficient data for interpolation.");
+    }
+
+    // Find the rows for which interpolation is to be performed
+    const Value target = static_cast<Value>(value);
+    size_t idx1 = 0, idx2 = 1;
+    Value diff1 = std::abs(rows[idx1][Key::index] - target);
+    Value diff2 = std::abs(rows[idx2][Key::index] - target);
+    for (size_t i = 2; i < rows.size(); ++i) {
+        Value currentDiff = std::abs(rows[i][Key::index] - target);
+        if (currentDiff < diff1) {
+            idx2 = idx1;
+            idx1 = i;
+            diff2 = diff1;
+            diff1 = currentDiff;
+        }
+        else if (currentDiff < diff2) {
+            idx2 = i;
+            diff2 = currentDiff;
+        }
+    }
+
+    const Value* row1 = rows[idx1];
+    const Value* row2 = rows[idx2];
+    // Ensure no division by zero
+    Value fraction = 0;
+    if (row2[Key::index] != row1[Key::index]) {
+        fraction = (target - row1[Key::index]) / (row2[Key::index] - row1[Key::index]);
+    }
+
+    return std::make_tuple(static_cast<double>(row1[Columns::index] + fraction * (row2[Columns::index] - row1[Columns::index]))...);
+}
+
+#endif // TABLESCHEMAS_H
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 // Implementing the constructor
 TrimStabilityReader::TrimStabilityReader(const std::string& fileName, const std::string& userInput) {
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+    floatingCondition = { missing, missing, missing, missing, missing, missing };
+
     // Validate userInput format
     if (!isValidInputFormat(userInput)) {
         throw std::runtime_error("Improper input format.");
@@ -13,10 +16,9 @@ TrimStabilityReader::TrimStabilityReader(const std::string& fileName, const std:
         throw std::runtime_error("Non-existent loading condition.");
     }
 
-    FPDF_InitLibrary();
+    PdfLibrary library;
     FPDF_DOCUMENT document = FPDF_LoadDocument(fileName.c_str(), nullptr);
     if (!document) {
-        FPDF_DestroyLibrary();
         throw std::runtime_error("Unable to open PDF file " + fileName);
     }
 
@@ -49,7 +51,6 @@ TrimStabilityReader::TrimStabilityReader(const std::string& fileName, const std:
     }
 
     FPDF_CloseDocument(document);
-    FPDF_DestroyLibrary();
 }
 
 // Implementing the getData method
@@ -62,6 +63,11 @@ const std::vector<double>& TrimStabilityReader::getDensities() const {
     return densities;
 }
 
+// Implementing the getFloatingCondition method
+const FloatingCondition& TrimStabilityReader::getFloatingCondition() const {
+    return floatingCondition;
+}
+
 // Implementing isValidInputFormat method
 bool TrimStabilityReader::isValidInputFormat(const std::string& userInput) {
     std::regex formatRegex(R"(\d{2})");
@@ -201,11 +207,13 @@ bool TrimStabilityReader::searchForPatterns(FPDF_TEXTPAGE textPage) {
             // Save the line where "Draught moulded" is found
             std::vector<double> values = extractNumericalValues(line, false, false);
             tankPlan["Floating Condition"].insert(tankPlan["Floating Condition"].end(), values.begin(), values.end());
+            readFloatingCondition(line, values);
             foundDraughtMoulded = true;
             // Now continue saving the next 5 lines
             for (int k = 0; k < 5 && std::getline(stream, line); ++k) {
                 std::vector<double> values = extractNumericalValues(line, false, false);
                 tankPlan["Floating Condition"].insert(tankPlan["Floating Condition"].end(), values.begin(), values.end());
+                readFloatingCondition(line, values);
             }
             break; // Stop searching after "Draught moulded" is found
         }
@@ -215,6 +223,39 @@ bool TrimStabilityReader::searchForPatterns(FPDF_TEXTPAGE textPage) {
     return foundDraughtMoulded;
 }
 
+// Implementing the readFloatingCondition method
+// Lines are matched by label rather than position, as the order of the block is not relied upon
+// A line may mention other quantities after its own label, e.g. "Trim (+ aft)", so the label found first in the line wins
+void TrimStabilityReader::readFloatingCondition(const std::string& line, const std::vector<double>& values) {
+    if (values.empty()) {
+        return;
+    }
+    static const std::regex draughtMouldedRegex(R"(Draught\s+moulded)", std::regex::icase);
+    static const std::regex foreRegex(R"(\bF\.?P\b|\bfore)", std::regex::icase);
+    static const std::regex aftRegex(R"(\bA\.?P\b|\baft)", std::regex::icase);
+    static const std::regex trimRegex(R"(\btrim\b)", std::regex::icase);
+    static const std::regex heelRegex(R"(\bheel\b|\blist\b)", std::regex::icase);
+    static const std::regex gmRegex(R"(\bG\.?M)", std::regex::icase);
+    const std::pair<const std::regex*, double FloatingCondition::*> labels[] = {
+        { &draughtMouldedRegex, &FloatingCondition::draughtMoulded }, { &foreRegex, &FloatingCondition::TF },
+        { &aftRegex, &FloatingCondition::TA }, { &trimRegex, &FloatingCondition::trim }, { &heelRegex, &FloatingCondition::heel },
+        { &gmRegex, &FloatingCondition::GM }
+    };
+
+    double FloatingCondition::* quantity = nullptr;
+    std::smatch::difference_type first = 0;
+    for (const auto& label : labels) {
+        std::smatch match;
+        if (std::regex_search(line, match, *label.first) && (!quantity || match.position(0) < first)) {
+            quantity = label.second;
+            first = match.position(0);
+        }
+    }
+    if (quantity) {
+        floatingCondition.*quantity = values[0];
+    }
+}
+
 // Implementing the extractNumericalValues method
 std::vector<double> TrimStabilityReader::extractNumericalValues(const std::string& line, bool skipFirst, bool skipNext) {
     std::vector<double> values;
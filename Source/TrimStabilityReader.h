@@ -8,8 +8,16 @@
 #include <regex>
 #include <fpdfview.h>
 #include <fpdf_text.h>
+#include "PdfLibrary.h"
 #include <stdexcept>
 #include <sstream>
+#include <limits>
+
+// Equilibrium printed by the book for the loading condition, used as a reference for the computed one
+// Values missing from the book are NaN
+struct FloatingCondition {
+    double draughtMoulded, trim, heel, TF, TA, GM;
+};
 
 class TrimStabilityReader {
 public:
@@ -19,9 +27,12 @@ public:
 
     const std::vector<double>& getDensities() const;
 
+    const FloatingCondition& getFloatingCondition() const;
+
 private:
     std::unordered_map<std::string, std::vector<double>> tankPlan;
     std::vector<double> densities;
+    FloatingCondition floatingCondition;
 
     bool isValidInputFormat(const std::string& userInput);
 
@@ -29,6 +40,9 @@ private:
 
     bool searchForPatterns(FPDF_TEXTPAGE textPage);
 
+    // Assigns the first value of a "Floating Condition" line to the quantity named by its label
+    void readFloatingCondition(const std::string& line, const std::vector<double>& values);
+
     std::vector<double> extractNumericalValues(const std::string& line, bool skipFirst, bool skipNext);
 };
 
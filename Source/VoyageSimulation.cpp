@@ -0,0 +1,235 @@
+#include "VoyageSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+// Implementing the constructor
+VoyageSimulation::VoyageSimulation(const std::string& routeFile) {
+    std::ifstream file(routeFile);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + routeFile + " for reading.");
+    }
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream stream(line);
+        std::string directive;
+        if (!(stream >> directive)) {
+            continue;
+        }
+        bool valid = true;
+        if (directive == "speed") {
+            valid = static_cast<bool>(stream >> route.speed);
+        }
+        else if (directive == "step") {
+            valid = static_cast<bool>(stream >> route.timeStep);
+        }
+        else if (directive == "block") {
+            valid = static_cast<bool>(stream >> route.blockCoefficient);
+        }
+        else if (directive == "waypoint") {
+            Waypoint waypoint = { 0.0, 0.0, 0.0, false };
+            std::string confined;
+            valid = static_cast<bool>(stream >> waypoint.distance >> waypoint.depth >> waypoint.density);
+            if (valid && stream >> confined) {
+                valid = (confined == "confined");
+                waypoint.confined = valid;
+            }
+            route.waypoints.push_back(waypoint);
+        }
+        else if (directive == "tide") {
+            TidePoint tide = { 0.0, 0.0 };
+            valid = static_cast<bool>(stream >> tide.time >> tide.height);
+            route.tides.push_back(tide);
+        }
+        else if (directive == "burn") {
+            BurnRate burn = { "", 0.0 };
+            valid = static_cast<bool>(stream >> burn.key >> burn.rate);
+            route.burnRates.push_back(burn);
+        }
+        else {
+            throw std::runtime_error("Unknown route directive " + directive + " on line " + std::to_string(lineNumber));
+        }
+        if (!valid) {
+            throw std::runtime_error("Invalid " + directive + " on line " + std::to_string(lineNumber) + " of " + routeFile);
+        }
+    }
+    validate();
+}
+
+// Implementing the constructor for a route
+VoyageSimulation::VoyageSimulation(const Route& route)
+    : route(route) {
+    validate();
+}
+
+// Implementing the getRoute method
+const Route& VoyageSimulation::getRoute() const {
+    return route;
+}
+
+// Implementing the writeHeader method
+void VoyageSimulation::writeHeader(std::ostream& output) {
+    output << "condition,time_h,distance_nm,depth_m,tide_m,density,displacement,tf,ta,trim,heel,gm,squat,ukc\n";
+}
+
+// Implementing the simulate method
+VoyageSummary VoyageSimulation::simulate(const Ship& ship, const std::string& label, std::ostream* output, std::mutex* outputMutex) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const ShipModel& model = ship.getModel();
+    const LoadingCondition& loadCond = ship.getLoadingCondition();
+    const CompartmentProperties& compartments = ship.getCompartments();
+
+    // Departure contributions of the burned tanks, which every step replaces with their drawn down contributions
+    struct Tank {
+        const std::string* key;
+        double rate, mass, fillPercentage;
+        double longitudinalMoment, transverseMoment, verticalMoment;
+    };
+    std::vector<Tank> tanks;
+    for (const BurnRate& burn : route.burnRates) {
+        auto it = compartments.find(burn.key);
+        if (it == compartments.end() || model.getSoundingTable(burn.key).empty()) {
+            throw std::runtime_error("Burned compartment not in the loading condition or without a sounding table: " + burn.key);
+        }
+        double mass, lcg, tcg, vcg, fsm;
+        std::tie(mass, lcg, tcg, vcg, fsm) = it->second;
+        tanks.push_back({ &burn.key, burn.rate, mass, loadCond.getFillPercentage(burn.key), mass * lcg, mass * tcg + fsm, mass * vcg });
+    }
+    double displacement, longitudinalMoment, transverseMoment, verticalMoment;
+    std::tie(displacement, longitudinalMoment, transverseMoment, verticalMoment) = ship.getMoments();
+
+    std::vector<char> buffer;
+    if (output) {
+        buffer.reserve(outputBufferSize);
+    }
+    auto flush = [&]() {
+        if (output && !buffer.empty()) {
+            std::unique_lock<std::mutex> lock;
+            if (outputMutex) {
+                lock = std::unique_lock<std::mutex>(*outputMutex);
+            }
+            output->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    };
+
+    VoyageSummary summary;
+    summary.label = label;
+    summary.steps = 0;
+    summary.minimumUKC = std::numeric_limits<double>::infinity();
+    summary.timeOfMinimum = 0.0;
+    summary.distanceOfMinimum = 0.0;
+
+    size_t leg = 0, tideIndex = 0;
+    const size_t stepCount = static_cast<size_t>(std::ceil(duration / route.timeStep - 1e-9)) + 1;
+    char line[320];
+    for (size_t n = 0; n < stepCount; ++n) {
+        const double time = std::min(n * route.timeStep, duration);
+        // Distances are those of the route, which need not start at 0 nm
+        const double distance = std::min(route.waypoints.front().distance + time * route.speed, route.waypoints.back().distance);
+
+        // Position on the route and tide, both found by moving forward from the previous step
+        while (leg + 2 < route.waypoints.size() && route.waypoints[leg + 1].distance <= distance) {
+            ++leg;
+        }
+        const Waypoint& from = route.waypoints[leg];
+        const Waypoint& to = route.waypoints[leg + 1];
+        const double legFraction = (to.distance > from.distance) ? (distance - from.distance) / (to.distance - from.distance) : 0.0;
+        const double depth = from.depth + legFraction * (to.depth - from.depth);
+        const double density = from.density + legFraction * (to.density - from.density);
+        const bool confined = from.confined || to.confined;
+        double tide = 0.0;
+        if (!route.tides.empty()) {
+            while (tideIndex + 2 < route.tides.size() && route.tides[tideIndex + 1].time <= time) {
+                ++tideIndex;
+            }
+            const TidePoint& before = route.tides[tideIndex];
+            const TidePoint& after = route.tides[std::min(tideIndex + 1, route.tides.size() - 1)];
+            double tideFraction = (after.time > before.time) ? (time - before.time) / (after.time - before.time) : 0.0;
+            tideFraction = std::max(0.0, std::min(1.0, tideFraction));
+            tide = before.height + tideFraction * (after.height - before.height);
+        }
+
+        // Draw the tanks down; the fill percentage of a tank is proportional to its volume, thus to its mass
+        double mass = displacement, longitudinal = longitudinalMoment, transverse = transverseMoment, vertical = verticalMoment;
+        for (const Tank& tank : tanks) {
+            const double remaining = std::max(tank.mass - tank.rate * time, 0.0);
+            const double fillPercentage = (tank.mass > 0.0) ? tank.fillPercentage * remaining / tank.mass : 0.0;
+            double tankMass, lcg, tcg, vcg, fsm;
+            std::tie(tankMass, lcg, tcg, vcg, fsm) = loadCond.evaluateFill(model, *tank.key, fillPercentage);
+            mass += tankMass - tank.mass;
+            longitudinal += tankMass * lcg - tank.longitudinalMoment;
+            transverse += tankMass * tcg + fsm - tank.transverseMoment;
+            vertical += tankMass * vcg - tank.verticalMoment;
+        }
+
+        // Displacement of sea water that takes up the same volume as the ship in water of the local density
+        const double scale = seaWaterDensity / density;
+        ShipResults results = Ship::solveEquilibrium(model, mass * scale, longitudinal * scale, transverse * scale, vertical * scale,
+            loadCond.getPrecision());
+        results.displacement = mass;
+
+        const double squat = route.blockCoefficient * route.speed * route.speed / (confined ? 50.0 : 100.0);
+        const double UKC = depth + tide - std::max(results.TF, results.TA) - squat;
+        if (UKC < summary.minimumUKC) {
+            summary.minimumUKC = UKC;
+            summary.timeOfMinimum = time;
+            summary.distanceOfMinimum = distance;
+        }
+        summary.arrival = results;
+        ++summary.steps;
+
+        if (output) {
+            int length = snprintf(line, sizeof(line), "%s,%.4f,%.4f,%.3f,%.3f,%.4f,%.3f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                label.c_str(), time, distance, depth, tide, density, mass, results.TF, results.TA, results.trim, results.heel, results.GM, squat, UKC);
+            length = std::min(length, static_cast<int>(sizeof(line)) - 1);
+            if (buffer.size() + length > outputBufferSize) {
+                flush();
+            }
+            buffer.insert(buffer.end(), line, line + length);
+        }
+    }
+    flush();
+    summary.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+// Implementing the run method
+std::vector<VoyageSummary> VoyageSimulation::run(const std::vector<const Ship*>& ships, const std::vector<std::string>& labels, std::ostream* output,
+    WorkStealingPool& pool) const {
+    if (labels.size() != ships.size()) {
+        throw std::invalid_argument("One label is required per ship.");
+    }
+    std::vector<VoyageSummary> summaries(ships.size());
+    std::mutex outputMutex;
+    pool.parallelFor(ships.size(), [&](size_t i) {
+        summaries[i] = simulate(*ships[i], labels[i], output, &outputMutex);
+        });
+    return summaries;
+}
+
+// Implementing the validate method
+void VoyageSimulation::validate() {
+    if (!(route.speed > 0.0) || !(route.timeStep > 0.0) || !(route.blockCoefficient > 0.0 && route.blockCoefficient <= 1.0)) {
+        throw std::runtime_error("Route speed, time step and block coefficient must be positive, the block coefficient at most 1.");
+    }
+    if (route.waypoints.size() < 2) {
+        throw std::runtime_error("A route needs at least two waypoints.");
+    }
+    for (size_t i = 0; i < route.waypoints.size(); ++i) {
+        if (!(route.waypoints[i].density > 0.0) || (i > 0 && route.waypoints[i].distance < route.waypoints[i - 1].distance)) {
+            throw std::runtime_error("Waypoints must be in order of distance, with positive water densities.");
+        }
+    }
+    for (size_t i = 1; i < route.tides.size(); ++i) {
+        if (route.tides[i].time < route.tides[i - 1].time) {
+            throw std::runtime_error("Tide heights must be in order of time.");
+        }
+    }
+    duration = (route.waypoints.back().distance - route.waypoints.front().distance) / route.speed;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef VOYAGESIMULATION_H
+#define VOYAGESIMULATION_H
+
+#include "Ship.h"
+#include "ShipModel.h"
+#include "WorkStealingPool.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <stdexcept>
+
+// Point of the route, at a distance from departure along the track
+struct Waypoint {
+    double distance; // [nm]
+    double depth; // Charted depth [m]
+    double density; // Water density [t/m3]
+    bool confined; // Channel or shallow water, where squat doubles
+};
+
+struct TidePoint {
+    double time; // From departure [h]
+    double height; // Above chart datum [m]
+};
+
+// Consumption of a tank, e.g. fuel oil or fresh water
+struct BurnRate {
+    std::string key;
+    double rate; // [t/h]
+};
+
+// Route file: one directive per line; blank lines and text after '#' are ignored
+//   speed <kn>                                          speed through the water
+//   step <h>                                            time step
+//   block <Cb>                                          block coefficient, for the squat
+//   waypoint <distance nm> <depth m> <t/m3> [confined]  depth and density are interpolated between waypoints
+//   tide <time h> <height m>                            tide series, interpolated in time
+//   burn <key> <t/h>
+struct Route {
+    double speed = 12.0;
+    double timeStep = 0.1;
+    double blockCoefficient = 0.82;
+    std::vector<Waypoint> waypoints;
+    std::vector<TidePoint> tides;
+    std::vector<BurnRate> burnRates;
+};
+
+// Worst point of the voyage of one departure condition
+struct VoyageSummary {
+    std::string label;
+    size_t steps;
+    double minimumUKC, timeOfMinimum, distanceOfMinimum;
+    ShipResults arrival;
+    // Elapsed time of the simulation [s]
+    double elapsed;
+};
+
+// Draughts and under-keel clearance along a route, for any number of departure conditions
+// At every time step the burned tanks are drawn down through LoadingCondition::evaluateFill, the moment totals of the ship
+// are updated by the change of those tanks alone, and the equilibrium is found in water of the local density:
+// the hydrostatic tables hold sea water of 1.025 t/m3, so they are entered with the displacement scaled by 1.025 / density
+// Squat follows Barrass, Cb * V^2 / 100 in open water and twice that in confined water, V being the speed in knots
+class VoyageSimulation {
+public:
+    explicit VoyageSimulation(const std::string& routeFile);
+
+    explicit VoyageSimulation(const Route& route);
+
+    const Route& getRoute() const;
+
+    static void writeHeader(std::ostream& output);
+
+    // Steps the voyage of one departure condition; if output is given, every step is written to it as a CSV row,
+    // in blocks taken under outputMutex when one is given
+    // Apart from one output buffer per voyage, the steps perform no heap allocation
+    VoyageSummary simulate(const Ship& ship, const std::string& label, std::ostream* output, std::mutex* outputMutex) const;
+
+    // One voyage per ship, over the pool; summaries are in the order of ships
+    std::vector<VoyageSummary> run(const std::vector<const Ship*>& ships, const std::vector<std::string>& labels, std::ostream* output,
+        WorkStealingPool& pool) const;
+
+private:
+    static constexpr double seaWaterDensity = 1.025;
+    static const size_t outputBufferSize = 1 << 16;
+
+    Route route;
+    double duration;
+
+    void validate();
+};
+
+#endif // VOYAGESIMULATION_H
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+// Pool whose task the current thread is running, if any
+static thread_local const WorkStealingPool* runningPool = nullptr;
+
+// Implementing the constructor
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : pendingRanges(0), generation(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.emplace_back(new Queue());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+// Implementing the destructor
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Implementing the parallelFor method
+void WorkStealingPool::parallelFor(size_t count, const std::function<void(size_t)>& task, size_t chunkSize) {
+    if (count == 0) {
+        return;
+    }
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+
+    // Nested call from a worker of this pool
+    if (runningPool == this) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(callMutex);
+    size_t rangeCount = (count + chunkSize - 1) / chunkSize;
+    std::unique_lock<std::mutex> lock(stateMutex);
+    pendingRanges = rangeCount;
+    error = nullptr;
+
+    // Deal the ranges round-robin, so that every worker starts with a share of the indices
+    for (size_t k = 0; k < rangeCount; ++k) {
+        Queue& queue = *queues[k % queues.size()];
+        std::lock_guard<std::mutex> queueLock(queue.mutex);
+        queue.ranges.push_back({ k * chunkSize, std::min((k + 1) * chunkSize, count), &task });
+    }
+
+    ++generation;
+    wake.notify_all();
+    finished.wait(lock, [this]() { return pendingRanges == 0; });
+
+    if (error) {
+        std::exception_ptr thrown = error;
+        error = nullptr;
+        std::rethrow_exception(thrown);
+    }
+}
+
+// Implementing the getThreadCount method
+size_t WorkStealingPool::getThreadCount() const {
+    return workers.size();
+}
+
+// Implementing the workerLoop method
+void WorkStealingPool::workerLoop(size_t index) {
+    runningPool = this;
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [this, seenGeneration]() { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        Range range;
+        while (takeRange(index, range)) {
+            std::exception_ptr thrown;
+            try {
+                for (size_t i = range.begin; i < range.end; ++i) {
+                    (*range.task)(i);
+                }
+            }
+            catch (...) {
+                thrown = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (thrown && !error) {
+                error = thrown;
+            }
+            if (--pendingRanges == 0) {
+                finished.notify_all();
+            }
+        }
+    }
+}
+
+// Implementing the takeRange method
+// Own queue first, from the back; then the other queues, from the front
+bool WorkStealingPool::takeRange(size_t index, Range& range) {
+    {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.ranges.empty()) {
+            range = queue.ranges.back();
+            queue.ranges.pop_back();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < queues.size(); ++k) {
+        Queue& queue = *queues[(index + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.ranges.empty()) {
+            range = queue.ranges.front();
+            queue.ranges.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
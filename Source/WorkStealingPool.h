@@ -0,0 +1,64 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <cstdint>
+
+// Fixed set of worker threads for running many independent tasks, e.g. scenario matrices
+// Every worker owns a queue of index ranges; it takes work from the back of its own queue
+// and, once that is empty, steals from the front of the others, so uneven tasks balance out
+class WorkStealingPool {
+public:
+    // Zero selects the number of hardware threads
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Calls task(i) for every i in [0, count), in ranges of chunkSize indices, and returns once all are done
+    // The first exception thrown by a task is rethrown here, after the remaining ranges have run
+    // Calls from several threads are safe: they run one after another, each waiting for the previous one to finish
+    // A call made from within a task of this pool runs its indices inline on the calling worker, since that worker
+    // cannot wait for ranges queued behind the one it is running
+    void parallelFor(size_t count, const std::function<void(size_t)>& task, size_t chunkSize = 1);
+
+    size_t getThreadCount() const;
+
+private:
+    // Indices [begin, end) of a call to parallelFor, with the task of that call
+    // Carrying the task with the range keeps a worker still draining one call from running another call's range with the wrong task
+    struct Range {
+        size_t begin, end;
+        const std::function<void(size_t)>* task;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    // Held for the whole of a call, so that pendingRanges and error always belong to a single call
+    std::mutex callMutex;
+    std::mutex stateMutex;
+    std::condition_variable wake, finished;
+    size_t pendingRanges;
+    uint64_t generation;
+    bool stopping;
+    std::exception_ptr error;
+
+    void workerLoop(size_t index);
+    bool takeRange(size_t index, Range& range);
+};
+
+#endif // WORKSTEALINGPOOL_H
\ No newline at end of file
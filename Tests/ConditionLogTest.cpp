@@ -0,0 +1,200 @@
+// Checks the record codec of ConditionLog without any ship data: conditions are appended and read back unchanged, through
+// keyframes, removed and added compartments and values that are not multiples of 1e-4; a damaged frame costs the records up to the
+// next keyframe only, and a truncated frame the last record only
+// Build with the sources of the project, e.g.
+//   g++ -std=c++14 -O2 -pthread -I Source Tests/ConditionLogTest.cpp Source/*.cpp (without Source/Loadicator.cpp) <PDF library>
+// and run with the name of a scratch file, ConditionLogTest.bin by default
+#include "ConditionLog.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+static const size_t keyframeInterval = 8;
+static const size_t conditionCount = 40;
+static const size_t headerSize = 20;
+static const size_t frameHeaderSize = 12;
+
+static size_t failures = 0;
+
+static void expect(bool condition, const std::string& message) {
+    if (!condition) {
+        ++failures;
+        std::cout << "FAIL: " << message << '\n';
+    }
+}
+
+// Values are compared bit for bit, so that NaN and -0.0 have to survive the round trip as well
+static bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+static bool sameRecord(const LoggedCondition& record, const ConditionDefinition& definition, Precision precision, const ShipResults& results) {
+    if (record.definition.label != definition.label || !sameBits(record.definition.densities, definition.densities)
+        || record.precision != precision || std::memcmp(&record.results, &results, sizeof(results)) != 0
+        || record.definition.tankPlan.size() != definition.tankPlan.size()) {
+        return false;
+    }
+    for (const auto& pair : definition.tankPlan) {
+        auto it = record.definition.tankPlan.find(pair.first);
+        if (it == record.definition.tankPlan.end() || !sameBits(it->second, pair.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Conditions that change from one to the next the way a planning session does, with some unusual values mixed in
+static void makeConditions(std::vector<ConditionDefinition>& definitions, std::vector<Precision>& precisions, std::vector<ShipResults>& results) {
+    for (size_t n = 0; n < conditionCount; ++n) {
+        ConditionDefinition definition;
+        definition.label = "Condition " + std::to_string(n);
+        definition.densities = { 0.75, 1.025, 0.99 };
+        if (n % 3 == 0) {
+            definition.densities.push_back(0.85 + 0.01 * static_cast<double>(n));
+        }
+        definition.tankPlan["Lightweight"] = { 24500.0, 128.0, 0.0, 13.5 };
+        for (int tank = 1; tank <= 6; ++tank) {
+            // Every fifth condition leaves a tank out, so that records remove and add compartments
+            if ((n + tank) % 5 != 0) {
+                definition.tankPlan["R2.0" + std::to_string(tank)] = { 0.0, static_cast<double>((n * 7 + tank * 13) % 101), 0.0, 0.0, 0.0, 0.0 };
+            }
+        }
+        definition.tankPlan["R1." + std::to_string(1 + n % 9)] = { 0.0, 62.2 + 0.0001 * static_cast<double>(n), 0.0, 0.0, 0.0, 0.0 };
+        definition.tankPlan["Crew and stores"] = { 35.0, 0.0, 240.0 - 1.0 / 3.0, n % 2 ? -0.0 : 0.0, 28.0, 0.0 };
+        if (n % 4 == 1) {
+            definition.tankPlan["Deck cargo"] = { 1e9 + 0.5, 0.0, -std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                1e-300, 12.0 };
+        }
+        definitions.push_back(definition);
+        precisions.push_back(n % 7 == 3 ? Precision::Single : Precision::Double);
+
+        double values[15];
+        for (int i = 0; i < 15; ++i) {
+            values[i] = static_cast<double>(n) * 100.0 + i + 1.0 / 7.0;
+        }
+        ShipResults result;
+        std::memcpy(&result, values, sizeof(result));
+        results.push_back(result);
+    }
+}
+
+static std::vector<char> readFile(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& fileName, const std::vector<char>& data) {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+// Offsets of the frames of the file, from their lengths
+static std::vector<size_t> frameOffsets(const std::vector<char>& data) {
+    std::vector<size_t> offsets;
+    size_t position = headerSize;
+    while (position + frameHeaderSize <= data.size()) {
+        uint32_t length;
+        std::memcpy(&length, data.data() + position + sizeof(uint32_t), sizeof(length));
+        offsets.push_back(position);
+        position += frameHeaderSize + length;
+    }
+    return offsets;
+}
+
+int main(int argc, char* argv[]) {
+    const std::string fileName = (argc > 1) ? argv[1] : "ConditionLogTest.bin";
+    const uint64_t fingerprint = 0x0123456789ABCDEFull;
+    std::remove(fileName.c_str());
+
+    try {
+        std::vector<ConditionDefinition> definitions;
+        std::vector<Precision> precisions;
+        std::vector<ShipResults> results;
+        makeConditions(definitions, precisions, results);
+        {
+            ConditionLog log(fileName, fingerprint, keyframeInterval);
+            for (size_t n = 0; n < conditionCount; ++n) {
+                log.append(definitions[n], precisions[n], results[n]);
+            }
+            expect(log.getRecordCount() == conditionCount, "record count of the writer");
+        }
+
+        // Round trip
+        std::vector<LoggedCondition> records;
+        LogReadStatistics statistics = ConditionLog::read(fileName, records);
+        expect(statistics.fingerprint == fingerprint, "fingerprint");
+        expect(statistics.records == conditionCount && statistics.corrupt == 0 && statistics.skipped == 0, "round trip statistics");
+        for (size_t n = 0; n < records.size() && n < conditionCount; ++n) {
+            expect(sameRecord(records[n], definitions[n], precisions[n], results[n]), "round trip of record " + std::to_string(n));
+            expect(n == 0 || records[n].timestamp >= records[n - 1].timestamp, "timestamp of record " + std::to_string(n));
+        }
+
+        const std::vector<char> original = readFile(fileName);
+        const std::vector<size_t> offsets = frameOffsets(original);
+        expect(offsets.size() == conditionCount, "frame count");
+
+        // A flipped byte in the payload of a delta record; the records after it are lost up to the next keyframe
+        const size_t damaged = keyframeInterval + 2;
+        std::vector<char> data = original;
+        data[offsets[damaged] + frameHeaderSize + 5] ^= 0x5A;
+        writeFile(fileName, data);
+        records.clear();
+        statistics = ConditionLog::read(fileName, records);
+        const size_t lost = 2 * keyframeInterval - damaged;
+        expect(statistics.corrupt == 1 && statistics.skipped == lost - 1 && statistics.records == conditionCount - lost,
+            "statistics after a damaged frame");
+        for (size_t k = 0, n = 0; k < records.size(); ++k, ++n) {
+            if (n == damaged) {
+                n += lost;
+            }
+            expect(n < conditionCount && sameRecord(records[k], definitions[n], precisions[n], results[n]),
+                "record " + std::to_string(n) + " after a damaged frame");
+        }
+
+        // A damaged sync word and a truncated last frame
+        data = original;
+        data[offsets[1]] ^= 0x01;
+        data.resize(data.size() - 3);
+        writeFile(fileName, data);
+        records.clear();
+        statistics = ConditionLog::read(fileName, records);
+        expect(statistics.corrupt == 2 && statistics.records == conditionCount - keyframeInterval,
+            "statistics after a damaged sync word and a truncated frame");
+        expect(!records.empty() && sameRecord(records[0], definitions[0], precisions[0], results[0]), "record before a damaged sync word");
+        expect(!records.empty() && sameRecord(records.back(), definitions[conditionCount - 2], precisions[conditionCount - 2],
+            results[conditionCount - 2]), "record before a truncated frame");
+
+        // Appending to an existing log continues it with a keyframe
+        writeFile(fileName, original);
+        {
+            ConditionLog log(fileName, fingerprint, keyframeInterval);
+            log.append(definitions[5], precisions[5], results[5]);
+        }
+        records.clear();
+        statistics = ConditionLog::read(fileName, records);
+        expect(statistics.records == conditionCount + 1 && statistics.corrupt == 0 && statistics.skipped == 0, "statistics after reopening");
+        expect(records.size() == conditionCount + 1 && sameRecord(records.back(), definitions[5], precisions[5], results[5]),
+            "record appended after reopening");
+
+        // A log of another ship model is refused
+        bool refused = false;
+        try {
+            ConditionLog log(fileName, fingerprint + 1, keyframeInterval);
+        }
+        catch (const std::runtime_error&) {
+            refused = true;
+        }
+        expect(refused, "log of other ship data refused");
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::remove(fileName.c_str());
+    std::cout << (failures == 0 ? "Condition log codec passed" : std::to_string(failures) + " checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
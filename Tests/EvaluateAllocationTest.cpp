@@ -0,0 +1,110 @@
+// Checks that steady-state evaluation performs no heap allocation: Ship::evaluate in double and single precision,
+// and Ship::updateSounding, once each condition has been evaluated a first time
+// Build with the sources of the project, e.g.
+//   g++ -std=c++14 -O2 -pthread -I Source Tests/EvaluateAllocationTest.cpp Source/*.cpp (without Source/Loadicator.cpp) <PDF library>
+// and run from the directory holding Data, optionally with the conditions to check (all 31 by default)
+#include "Ship.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+// Allocations made by the calls of step, after a first call has warmed every buffer up
+template <class Step>
+static size_t countAllocations(Step step) {
+    const int repeats = 1000;
+    step(0);
+    const size_t before = allocationCount.load();
+    for (int k = 1; k <= repeats; ++k) {
+        step(k);
+    }
+    return allocationCount.load() - before;
+}
+
+int main(int argc, char* argv[]) {
+    const std::string trimStabilityBook = "Data/Trim and stability book.pdf";
+    const std::string soundingTables = "Data/Sounding tables (1).txt";
+    const std::string hydrostaticTables = "Data/Hydrostatic tables.pdf";
+
+    std::vector<std::string> conditions;
+    for (int i = 1; i < argc; ++i) {
+        conditions.push_back(argv[i]);
+    }
+    if (conditions.empty()) {
+        char condition[3];
+        for (int i = 1; i <= 31; ++i) {
+            std::snprintf(condition, sizeof(condition), "%02d", i);
+            conditions.push_back(condition);
+        }
+    }
+
+    try {
+        std::shared_ptr<const ShipModel> model = ShipModel::loadAsync(soundingTables, hydrostaticTables).get();
+        size_t failures = 0;
+        for (const std::string& condition : conditions) {
+            Ship ship(model, trimStabilityBook, condition);
+            const size_t doubleAllocations = countAllocations([&ship](int) { ship.evaluate(); });
+
+            // A gauged tank of the condition, sounded up and down around its current level
+            size_t soundingAllocations = 0;
+            for (const auto& compartment : ship.getCompartments()) {
+                TableView<SoundingTableSchema> table = model->getSoundingTable(compartment.first);
+                if (!table.empty()) {
+                    const std::string key = compartment.first;
+                    const double top = table[table.size() - 1][SoundingTableSchema::Sounding::index];
+                    soundingAllocations = countAllocations([&ship, &key, top](int k) { ship.updateSounding(key, top * (k % 100) / 100.0); });
+                    break;
+                }
+            }
+
+            ship.setPrecision(Precision::Single);
+            const size_t singleAllocations = countAllocations([&ship](int) { ship.evaluate(); });
+
+            const bool passed = doubleAllocations == 0 && soundingAllocations == 0 && singleAllocations == 0;
+            if (!passed) {
+                ++failures;
+            }
+            std::cout << "Condition " << condition << ": evaluate " << doubleAllocations << ", updateSounding " << soundingAllocations
+                << ", single precision evaluate " << singleAllocations << " allocations" << (passed ? "" : " (FAIL)") << '\n';
+        }
+        std::cout << (failures == 0 ? "No allocation in steady-state evaluation" : std::to_string(failures) + " conditions allocated") << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file